@@ -0,0 +1,45 @@
+#pragma once
+
+#include <eosio/print.hpp>
+
+// Table operation counters for the benchmark scripts, only compiled in with BENCHMARK=1 (see scripts/compile.js).
+//
+// read      - a primary lookup or a row read through an iterator
+// write     - an emplace, modify or erase
+// secondary - a secondary index lookup or step, or a secondary key rewritten by a write
+//
+// An action adds up its own operations and prints "bench reads=.. writes=.. secondary=.." at the end,
+// scripts/benchmark.harvest.js reads that line from the action's console trace.
+
+#ifdef SEEDS_BENCHMARK
+
+namespace benchmark {
+
+  struct counters {
+    uint64_t reads = 0;
+    uint64_t writes = 0;
+    uint64_t secondary = 0;
+  };
+
+  // contract memory only lives for one action, so the counts are per action
+  inline counters & get() {
+    static counters c;
+    return c;
+  }
+
+}
+
+#define BENCH_READ(n) (benchmark::get().reads += (n))
+#define BENCH_WRITE(n) (benchmark::get().writes += (n))
+#define BENCH_SECONDARY(n) (benchmark::get().secondary += (n))
+#define BENCH_PRINT() eosio::print("bench reads=", benchmark::get().reads, \
+  " writes=", benchmark::get().writes, " secondary=", benchmark::get().secondary, "\n")
+
+#else
+
+#define BENCH_READ(n)
+#define BENCH_WRITE(n)
+#define BENCH_SECONDARY(n)
+#define BENCH_PRINT()
+
+#endif
@@ -23,6 +23,8 @@ namespace hypha
         const bool isEmpty() const;
 
         const std::string toString() const;
+        void appendTo(std::string &out) const;
+        const size_t serializedSizeHint() const;
 
         // NOTE: not using m_ notation because this changes serialization format
         std::string label;
@@ -94,6 +94,7 @@ namespace hypha
         const std::string toString();
         static const std::string toString(const ContentGroups &contentGroups);
         static const std::string toString(const ContentGroup &contentGroup);
+        static void appendTo(std::string &out, const ContentGroup &contentGroup);
 
         EOSLIB_SERIALIZE(Document, (id)(hash)(creator)(content_groups)(certificates)(created_date)(contract))
 
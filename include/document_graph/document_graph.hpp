@@ -39,6 +39,7 @@ namespace hypha
                                 ContentGroups content_groups);
 
         void replaceNode(const eosio::checksum256 &oldNode, const eosio::checksum256 &newNode);
+        bool migrateEdges(uint64_t limit);
         void eraseDocument(const eosio::checksum256 &document_hash);
         void eraseDocument(const eosio::checksum256 &document_hash, const bool includeEdges);
 
@@ -59,12 +60,12 @@ using document_table =  eosio::multi_index<eosio::name("documents"), contract_do
 using root_edge = hypha::Edge;\
 TABLE contract##_edge : public root_edge {};\
 using contract_edge = contract##_edge;\
-using edge_table = eosio::multi_index<eosio::name("edges"), contract_edge,\
+using edge_table = eosio::multi_index<eosio::name("graphedges"), contract_edge,\
             eosio::indexed_by<eosio::name("fromnode"), eosio::const_mem_fun<root_edge, eosio::checksum256, &root_edge::by_from>>,\
             eosio::indexed_by<eosio::name("tonode"), eosio::const_mem_fun<root_edge, eosio::checksum256, &root_edge::by_to>>,\
             eosio::indexed_by<eosio::name("edgename"), eosio::const_mem_fun<root_edge, uint64_t, &root_edge::by_edge_name>>,\
-            eosio::indexed_by<eosio::name("byfromname"), eosio::const_mem_fun<root_edge, uint64_t, &root_edge::by_from_node_edge_name_index>>,\
-            eosio::indexed_by<eosio::name("byfromto"), eosio::const_mem_fun<root_edge, uint64_t, &root_edge::by_from_node_to_node_index>>,\
-            eosio::indexed_by<eosio::name("bytoname"), eosio::const_mem_fun<root_edge, uint64_t, &root_edge::by_to_node_edge_name_index>>,\
+            eosio::indexed_by<eosio::name("byfromname"), eosio::const_mem_fun<root_edge, eosio::checksum256, &root_edge::by_from_node_edge_name_index>>,\
+            eosio::indexed_by<eosio::name("byfromto"), eosio::const_mem_fun<root_edge, eosio::checksum256, &root_edge::by_from_node_to_node_index>>,\
+            eosio::indexed_by<eosio::name("bytoname"), eosio::const_mem_fun<root_edge, eosio::checksum256, &root_edge::by_to_node_edge_name_index>>,\
             eosio::indexed_by<eosio::name("bycreated"), eosio::const_mem_fun<root_edge, uint64_t, &root_edge::by_created>>,\
             eosio::indexed_by<eosio::name("bycreator"), eosio::const_mem_fun<root_edge, uint64_t, &root_edge::by_creator>>>;
\ No newline at end of file
@@ -58,12 +58,7 @@ namespace hypha
                            const eosio::checksum256 &_to_node,
                            const eosio::name &_edge_name);
 
-        uint64_t id; // hash of from_node, to_node, and edge_name
-
-        // these three additional indexes allow isolating/querying edges more precisely (less iteration)
-        uint64_t from_node_edge_name_index;
-        uint64_t from_node_to_node_index;
-        uint64_t to_node_edge_name_index;
+        uint64_t id; // hash of from_node, to_node, and edge_name folded to 64 bits, moved to the next free id on collision
 
         // these members should be private, but they are used in DocumentGraph for edge replacement logic
         eosio::checksum256 from_node;
@@ -74,27 +69,78 @@ namespace hypha
         eosio::name contract;
 
         uint64_t primary_key() const;
-        uint64_t by_from_node_edge_name_index() const;
-        uint64_t by_from_node_to_node_index() const;
-        uint64_t by_to_node_edge_name_index() const;
+
+        // these three additional indexes allow isolating/querying edges more precisely (less iteration)
+        // they are sha256 of the raw node bytes and edge name, so they are not stored on the row
+        eosio::checksum256 by_from_node_edge_name_index() const;
+        eosio::checksum256 by_from_node_to_node_index() const;
+        eosio::checksum256 by_to_node_edge_name_index() const;
         uint64_t by_edge_name() const;
         uint64_t by_created() const;
         uint64_t by_creator() const;
         eosio::checksum256 by_from() const;
         eosio::checksum256 by_to() const;
 
-        EOSLIB_SERIALIZE(Edge, (id)(from_node_edge_name_index)(from_node_to_node_index)(to_node_edge_name_index)(from_node)(to_node)(edge_name)(created_date)(creator)(contract))
+        EOSLIB_SERIALIZE(Edge, (id)(from_node)(to_node)(edge_name)(created_date)(creator)(contract))
 
-        typedef eosio::multi_index<eosio::name("edges"), Edge,
+        typedef eosio::multi_index<eosio::name("graphedges"), Edge,
                                    eosio::indexed_by<eosio::name("fromnode"), eosio::const_mem_fun<Edge, eosio::checksum256, &Edge::by_from>>,
                                    eosio::indexed_by<eosio::name("tonode"), eosio::const_mem_fun<Edge, eosio::checksum256, &Edge::by_to>>,
                                    eosio::indexed_by<eosio::name("edgename"), eosio::const_mem_fun<Edge, uint64_t, &Edge::by_edge_name>>,
-                                   eosio::indexed_by<eosio::name("byfromname"), eosio::const_mem_fun<Edge, uint64_t, &Edge::by_from_node_edge_name_index>>,
-                                   eosio::indexed_by<eosio::name("byfromto"), eosio::const_mem_fun<Edge, uint64_t, &Edge::by_from_node_to_node_index>>,
-                                   eosio::indexed_by<eosio::name("bytoname"), eosio::const_mem_fun<Edge, uint64_t, &Edge::by_to_node_edge_name_index>>,
+                                   eosio::indexed_by<eosio::name("byfromname"), eosio::const_mem_fun<Edge, eosio::checksum256, &Edge::by_from_node_edge_name_index>>,
+                                   eosio::indexed_by<eosio::name("byfromto"), eosio::const_mem_fun<Edge, eosio::checksum256, &Edge::by_from_node_to_node_index>>,
+                                   eosio::indexed_by<eosio::name("bytoname"), eosio::const_mem_fun<Edge, eosio::checksum256, &Edge::by_to_node_edge_name_index>>,
                                    eosio::indexed_by<eosio::name("bycreated"), eosio::const_mem_fun<Edge, uint64_t, &Edge::by_created>>,
                                    eosio::indexed_by<eosio::name("bycreator"), eosio::const_mem_fun<Edge, uint64_t, &Edge::by_creator>>>
             edge_table;
+
+        // the edges table, fails while quests::migrateedges is still moving legacy edges over
+        static edge_table table(const eosio::name &contract);
+
+        // folds the edge hash and probes past ids already taken by other edges
+        static uint64_t newId(edge_table &e_t,
+                              const eosio::checksum256 &from_node,
+                              const eosio::checksum256 &to_node,
+                              const eosio::name &edge_name);
+    };
+
+    // the old edges table, its 32 bit string hash indexes collide - only read by DocumentGraph::migrateEdges
+    struct LegacyEdge
+    {
+        uint64_t id;
+        uint64_t from_node_edge_name_index;
+        uint64_t from_node_to_node_index;
+        uint64_t to_node_edge_name_index;
+
+        eosio::checksum256 from_node;
+        eosio::checksum256 to_node;
+        eosio::name edge_name;
+        eosio::time_point created_date;
+        eosio::name creator;
+        eosio::name contract;
+
+        uint64_t primary_key() const { return id; }
+        uint64_t by_from_node_edge_name_index() const { return from_node_edge_name_index; }
+        uint64_t by_from_node_to_node_index() const { return from_node_to_node_index; }
+        uint64_t by_to_node_edge_name_index() const { return to_node_edge_name_index; }
+        uint64_t by_edge_name() const { return edge_name.value; }
+        uint64_t by_created() const { return created_date.sec_since_epoch(); }
+        uint64_t by_creator() const { return creator.value; }
+        eosio::checksum256 by_from() const { return from_node; }
+        eosio::checksum256 by_to() const { return to_node; }
+
+        EOSLIB_SERIALIZE(LegacyEdge, (id)(from_node_edge_name_index)(from_node_to_node_index)(to_node_edge_name_index)(from_node)(to_node)(edge_name)(created_date)(creator)(contract))
+
+        typedef eosio::multi_index<eosio::name("edges"), LegacyEdge,
+                                   eosio::indexed_by<eosio::name("fromnode"), eosio::const_mem_fun<LegacyEdge, eosio::checksum256, &LegacyEdge::by_from>>,
+                                   eosio::indexed_by<eosio::name("tonode"), eosio::const_mem_fun<LegacyEdge, eosio::checksum256, &LegacyEdge::by_to>>,
+                                   eosio::indexed_by<eosio::name("edgename"), eosio::const_mem_fun<LegacyEdge, uint64_t, &LegacyEdge::by_edge_name>>,
+                                   eosio::indexed_by<eosio::name("byfromname"), eosio::const_mem_fun<LegacyEdge, uint64_t, &LegacyEdge::by_from_node_edge_name_index>>,
+                                   eosio::indexed_by<eosio::name("byfromto"), eosio::const_mem_fun<LegacyEdge, uint64_t, &LegacyEdge::by_from_node_to_node_index>>,
+                                   eosio::indexed_by<eosio::name("bytoname"), eosio::const_mem_fun<LegacyEdge, uint64_t, &LegacyEdge::by_to_node_edge_name_index>>,
+                                   eosio::indexed_by<eosio::name("bycreated"), eosio::const_mem_fun<LegacyEdge, uint64_t, &LegacyEdge::by_created>>,
+                                   eosio::indexed_by<eosio::name("bycreator"), eosio::const_mem_fun<LegacyEdge, uint64_t, &LegacyEdge::by_creator>>>
+            edge_table;
     };
 
 } // namespace hypha
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include <eosio/name.hpp>
+#include <eosio/crypto.hpp>
+
+#include <document_graph/edge.hpp>
+
+namespace hypha
+{
+    // Edge lists looked up through DocumentGraph, kept for the rest of the action - contract
+    // memory does not outlive it. Edge and DocumentGraph drop the lists an edge belongs to
+    // whenever they write or erase it, anything else writing to the edges table must call clear().
+    class EdgeCache
+    {
+    public:
+        enum Lookup : uint8_t
+        {
+            FROM_TO = 0,
+            FROM_NAME = 1,
+            TO_NAME = 2
+        };
+
+        struct Key
+        {
+            eosio::name contract;
+            uint8_t lookup;
+            eosio::checksum256 node;
+            eosio::checksum256 other_node;
+            eosio::name edge_name;
+
+            bool operator<(const Key &other) const
+            {
+                return std::tie(contract, lookup, node, other_node, edge_name) <
+                       std::tie(other.contract, other.lookup, other.node, other.other_node, other.edge_name);
+            }
+        };
+
+        static Key fromTo(const eosio::name &contract, const eosio::checksum256 &fromNode, const eosio::checksum256 &toNode);
+        static Key fromName(const eosio::name &contract, const eosio::checksum256 &fromNode, const eosio::name &edgeName);
+        static Key toName(const eosio::name &contract, const eosio::checksum256 &toNode, const eosio::name &edgeName);
+
+        // nullptr if the list was not read yet in this action
+        static const std::vector<Edge> *find(const Key &key);
+        static const std::vector<Edge> &store(const Key &key, std::vector<Edge> edges);
+
+        // drops the three lists the edge is part of
+        static void invalidate(const eosio::name &contract,
+                               const eosio::checksum256 &fromNode,
+                               const eosio::checksum256 &toNode,
+                               const eosio::name &edgeName);
+        static void invalidate(const Edge &edge);
+        static void clear();
+
+    private:
+        static std::map<Key, std::vector<Edge>> &lists();
+    };
+
+} // namespace hypha
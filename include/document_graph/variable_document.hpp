@@ -0,0 +1,31 @@
+#pragma once
+
+#include <eosio/name.hpp>
+#include <eosio/crypto.hpp>
+
+#include <document_graph/content.hpp>
+#include <document_graph/document.hpp>
+
+namespace hypha
+{
+    // A document whose hash is fixed when it is created and is used as its id from then on.
+    // Its content can change in place: no re-hashing, and the edges pointing at it stay as they are.
+    //
+    // Documents written before this type existed can be read as variable documents as they are,
+    // their current hash simply becomes their id.
+    class VariableDocument : public Document
+    {
+    public:
+        VariableDocument();
+
+        // populates the document and emplaces it, same as Document
+        VariableDocument(eosio::name contract, eosio::name creator, ContentGroups contentGroups);
+
+        // reads the document by its id; the hash is not checked against the content
+        VariableDocument(eosio::name contract, const eosio::checksum256 &hash);
+
+        // writes the content groups to the existing row, one row write
+        void modify();
+    };
+
+} // namespace hypha
@@ -11,6 +11,7 @@
 #include <tables/config_float_table.hpp>
 #include <tables/deferred_id_table.hpp>
 #include <utils.hpp>
+#include <map>
 
 using namespace eosio;
 using std::string;
@@ -29,6 +30,8 @@ CONTRACT accounts : public contract {
           flags(receiver, receiver.value),
           rep(receiver, receiver.value),
           sizes(receiver, receiver.value),
+          banqueue(receiver, receiver.value),
+          flagqueue(receiver, receiver.value),
           balances(contracts::harvest, contracts::harvest.value),
           config(contracts::settings, contracts::settings.value),
           configfloat(contracts::settings, contracts::settings.value),
@@ -56,10 +59,17 @@ CONTRACT accounts : public contract {
 
       ACTION invitevouch(name referrer, name invited);
 
+      // adduser + addref + invitevouch for a batch of invited individuals (referrer, account, nickname),
+      // accounts that are already users are skipped
+      ACTION onboardusers(std::vector<std::tuple<name, name, string>> invites);
+
       ACTION addrep(name user, uint64_t amount);
 
       ACTION subrep(name user, uint64_t amount);
 
+      // applies many rep changes in one action, users that don't exist are skipped
+      ACTION addreps(std::vector<std::pair<name, int64_t>> reps);
+
       ACTION addcbs(name account, int points);
 
       ACTION requestvouch(name account, name sponsor);
@@ -70,6 +80,8 @@ CONTRACT accounts : public contract {
       ACTION rankreps();
       ACTION rankorgreps();
       ACTION rankrep(uint64_t start_val, uint64_t chunk, uint64_t chunksize, name scope);
+      ACTION mergereps(name scope, uint64_t chunksize);
+      ACTION rerankrep(name scope, uint64_t chunksize);
 
       ACTION rankcbss();
       ACTION rankorgcbss();
@@ -82,10 +94,12 @@ CONTRACT accounts : public contract {
       ACTION delegateflag(name delegator, name delegatee);
       ACTION undlgateflag(name delegator);
       ACTION mimicflag(name delegatee, name to, name action, uint64_t chunksize);
+      ACTION flagbatch();
       ACTION punish(name account, uint64_t points);
       ACTION pnshvouchers(name account, uint64_t points, uint64_t start);
       ACTION evaldemote(name to, uint64_t start_val, uint64_t chunk, uint64_t chunksize);
       ACTION bantree(name account, bool recurse);
+      ACTION banbatch();
       ACTION refinfo(name account);
       ACTION unban(name account);
 
@@ -96,6 +110,9 @@ CONTRACT accounts : public contract {
       ACTION testsetrep(name user, uint64_t amount);
       ACTION testsetrs(name user, uint64_t amount);
       ACTION testsetcbs(name user, uint64_t amount);
+#ifdef SEEDS_BENCHMARK
+      ACTION testseedrep(uint64_t start, uint64_t count);
+#endif
 
       ACTION testmvouch(name sponsor, name account, uint64_t reps);
 
@@ -165,6 +182,14 @@ CONTRACT accounts : public contract {
       uint64_t countrefs(name user, int check_num_residents);
       uint64_t rep_score(name user);
       void add_rep_item(name account, uint64_t reputation, name scope);
+      void change_rep(name account, name scope, int64_t delta);
+      void change_user_rep(name user, int64_t delta);
+      void apply_rep_change(name account, name scope, int64_t delta);
+      void rep_count_change(name scope, uint64_t rep, int64_t delta);
+      bool rep_position(name account, name scope, uint64_t total, uint64_t max_steps, uint64_t & position);
+      void mark_rep_dirty(name account, name scope);
+      void start_rank_rep(name scope);
+      void eval_demote_rank(name account, uint64_t rank);
       uint64_t config_get(name key);
       double config_float_get(name key);
       void size_change(name id, int delta);
@@ -178,10 +203,17 @@ CONTRACT accounts : public contract {
       void send_punish(name account, uint64_t points);
       void send_eval_demote(name to);
       void send_punish_vouchers(name account, uint64_t points);
-      void calc_vouch_rep(name account);
+      void calc_vouch_rep(name account, int64_t vouch_delta);
+      int64_t change_vouch_points(name account, int64_t vouch_delta, uint64_t max_vouch);
       name get_scope(name type);
       void send_add_cbs_org(name user, uint64_t amount);
-      void send_bantree(name account);
+      void ban_tree_batch();
+      bool ban_account(name account);
+      uint64_t add_flag(name from, name to);
+      uint64_t remove_flag(name from, name to);
+      void apply_flag_totals(name to, int64_t delta);
+      void queue_mimic_flag(name delegatee, name to, name action, uint64_t depth);
+      void send_flag_batch();
       void check_is_banned(name account);
       uint64_t number_of_citizens_vouched(name account, uint64_t maxsearch);
       bool is_citizen(name account);
@@ -198,6 +230,39 @@ CONTRACT accounts : public contract {
 
       DEFINE_SIZE_TABLE_MULTI_INDEX
 
+      DEFINE_RANK_LOCK_TABLE
+
+      DEFINE_RANK_LOCK_TABLE_MULTI_INDEX
+
+      // rep changes buffered while rankrep walks the scope, merged by mergereps
+      TABLE rep_pending_table { // scoped by rep scope
+        name account;
+        int64_t delta;
+
+        uint64_t primary_key() const { return account.value; }
+      };
+
+      typedef eosio::multi_index<"reppending"_n, rep_pending_table> rep_pending_tables;
+
+      // number of rep rows per rep value, kept by apply_rep_change and rebuilt by rankrep
+      TABLE rep_count_table { // scoped by rep scope
+        uint64_t rep;
+        uint64_t count;
+
+        uint64_t primary_key() const { return rep; }
+      };
+
+      typedef eosio::multi_index<"repcounts"_n, rep_count_table> rep_count_tables;
+
+      // accounts whose rep changed since their rank was last set, reranked one by one by rerankrep
+      TABLE rep_dirty_table { // scoped by rep scope
+        name account;
+
+        uint64_t primary_key() const { return account.value; }
+      };
+
+      typedef eosio::multi_index<"repdirty"_n, rep_dirty_table> rep_dirty_tables;
+
       DEFINE_CBS_TABLE
 
       DEFINE_CBS_TABLE_MULTI_INDEX
@@ -205,6 +270,31 @@ CONTRACT accounts : public contract {
       DEFINE_BAN_TABLE
       DEFINE_BAN_TABLE_MULTI_INDEX
 
+      // accounts whose invited still have to be banned by bantree, in BFS order
+      TABLE ban_queue_table {
+        uint64_t id;
+        name account;
+        uint64_t next_invited; // where to continue if the account's invited didn't fit in one batch
+
+        uint64_t primary_key() const { return id; }
+      };
+
+      typedef eosio::multi_index<"banqueue"_n, ban_queue_table> ban_queue_tables;
+
+      // flags and flag removals still to be copied to the delegators of delegatee
+      TABLE flag_queue_table {
+        uint64_t id;
+        name delegatee;
+        name to;
+        name action; // flag or removeflag
+        uint64_t depth;
+        uint64_t next_delegator; // where to continue if the delegators didn't fit in one batch
+
+        uint64_t primary_key() const { return id; }
+      };
+
+      typedef eosio::multi_index<"flagqueue"_n, flag_queue_table> flag_queue_tables;
+
       TABLE ref_table {
         name referrer;
         name invited;
@@ -375,6 +465,8 @@ CONTRACT accounts : public contract {
     user_tables users;
     rep_tables rep;
     size_tables sizes;
+    ban_queue_tables banqueue;
+    flag_queue_tables flagqueue;
 
     size_tables history_sizes;
     resident_tables residents;
@@ -424,13 +516,21 @@ CONTRACT accounts : public contract {
 
 };
 
-EOSIO_DISPATCH(accounts, (reset)(adduser)(canresident)(makeresident)(cancitizen)(makecitizen)(update)(addref)(invitevouch)(addrep)(changesize)
-(subrep)(testsetrep)(testsetrs)(testcitizen)(testresident)(testvisitor)(testremove)(testsetcbs)
+// benchmark only actions are left out of the contract unless it is compiled with BENCHMARK=1 (see scripts/compile.js)
+#ifdef SEEDS_BENCHMARK
+#define ACCOUNTS_BENCHMARK_ACTIONS (testseedrep)
+#else
+#define ACCOUNTS_BENCHMARK_ACTIONS
+#endif
+
+EOSIO_DISPATCH(accounts, (reset)(adduser)(canresident)(makeresident)(cancitizen)(makecitizen)(update)(addref)(invitevouch)(onboardusers)(addrep)(changesize)
+(subrep)(addreps)(testsetrep)(testsetrs)(testcitizen)(testresident)(testvisitor)(testremove)(testsetcbs)
 (requestvouch)(vouch)(pnishvouched)
-(rankreps)(rankorgreps)(rankrep)(rankcbss)(rankorgcbss)(rankcbs)
-(flag)(removeflag)(punish)(pnshvouchers)(evaldemote)(bantree)(delegateflag)(undlgateflag)(mimicflag)
+(rankreps)(rankorgreps)(rankrep)(mergereps)(rerankrep)(rankcbss)(rankorgcbss)(rankcbs)
+(flag)(removeflag)(punish)(pnshvouchers)(evaldemote)(bantree)(banbatch)(delegateflag)(undlgateflag)(mimicflag)(flagbatch)
 (refinfo)(unban)
 (testmvouch)
 (migflags)(migflags1)
 (addcbs)
+ACCOUNTS_BENCHMARK_ACTIONS
 );
@@ -6,6 +6,7 @@
 #include <eosio/time.hpp>
 #include <eosio/transaction.hpp>
 #include <eosio/singleton.hpp>
+#include <eosio/binary_extension.hpp>
 #include <contracts.hpp>
 #include <utils.hpp>
 #include <tables/config_table.hpp>
@@ -111,8 +112,6 @@ CONTRACT dao : public contract {
 
       ACTION decayvoices();
 
-      ACTION decayvoice(const uint64_t & start, const uint64_t & chunksize);
-
       ACTION mimicrevert(const name & delegatee, const uint64_t & delegator, const name & scope, const uint64_t & proposal_id, const uint64_t & chunksize);
 
       ACTION updatevoices();
@@ -200,6 +199,8 @@ CONTRACT dao : public contract {
         uint64_t propcycle; 
         uint64_t t_onperiod; // last time onperiod ran
         uint64_t t_voicedecay; // last time voice was decayed
+        eosio::binary_extension<double> decay_index; // sum of -log(1 - decay) over all decays
+        eosio::binary_extension<uint64_t> decay_epoch; // bumped by a 100% decay, older voice is 0
       };
       typedef singleton<"cycle"_n, cycle_table> cycle_tables;
       typedef eosio::multi_index<"cycle"_n, cycle_table> dump_for_cycle;
@@ -214,9 +215,12 @@ CONTRACT dao : public contract {
       };
       typedef eosio::multi_index<"votes"_n, vote_table> votes_tables;
 
+      // balance is as of decay_index / decay_epoch, use voice_balance to read it
       TABLE voice_table {
         name account;
         uint64_t balance;
+        eosio::binary_extension<double> decay_index;
+        eosio::binary_extension<uint64_t> decay_epoch;
 
         uint64_t primary_key()const { return account.value; }
       };
@@ -359,6 +363,8 @@ CONTRACT dao : public contract {
 
   private:
 
+    uint64_t voice_balance(const voice_table & v);
+    void stamp_voice(voice_table & v);
     void set_voice(const name & user, const uint64_t & amount, const name & scope);
     double voice_change(const name & user, const uint64_t & amount, const bool & reduce, const name & scope);
     void erase_voice(const name & user);
@@ -397,7 +403,7 @@ extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) {
           (changetrust)(addactive)
           (favour)(against)(neutral)(revertvote)(voteonbehalf)
           (delegate)(undelegate)(mimicvote)(mimicrevert)
-          (decayvoices)(decayvoice)
+          (decayvoices)
           (updatevoices)(updatevoice)
           (erasepartpts)
           (createdho)(removedho)(removedhovts)(votedhos)(dhomimicvote)(dhocleanvts)(dhocleanvote)(dhocalcdists)
@@ -6,6 +6,7 @@
 #include <utils.hpp>
 #include <tables/config_table.hpp>
 #include <tables/proposals_table.hpp>
+#include <set>
 
 using namespace eosio;
 using std::string;
@@ -40,6 +41,11 @@ CONTRACT escrow : public contract {
 
         ACTION miglock(uint64_t lock_id);
 
+        // moves chunksize locks at a time from the old locks table to tokenlocks, keeping their ids
+        ACTION migratelocks(uint64_t chunksize);
+
+        ACTION testlgcylock(name sponsor, name beneficiary, asset quantity, string notes);
+
         ACTION cancellock (const uint64_t& lock_id);
 
         ACTION claim(name beneficiary);
@@ -119,10 +125,38 @@ CONTRACT escrow : public contract {
             name        trigger_event;  // e.g. "golive" 
             name        trigger_source; // the account that has permissions to trigger the event
             time_point  vesting_date;
+            name        proposal_contract; // proposals or dao if the lock pays out a proposal, read from the notes
+            uint64_t    proposal_id;
             string      notes;
         
             time_point  created_date   = current_block_time().to_time_point();
-            time_point  updated_date   = current_block_time().to_time_point();
+
+            uint64_t    primary_key()       const { return id; }
+
+            // event locks sort first so claim always checks their event, time locks only once they vested
+            uint128_t   by_beneficiary_vesting() const {
+                uint64_t vesting = lock_type == "time"_n ? vesting_date.sec_since_epoch() : 0;
+                return (uint128_t(beneficiary.value) << 64) | vesting;
+            }
+        };
+
+        typedef eosio::multi_index<"tokenlocks"_n, token_lock,
+            indexed_by<"bybenvesting"_n, const_mem_fun<token_lock, uint128_t, &token_lock::by_beneficiary_vesting>>
+        > token_lock_table;
+
+        // the old locks table, every lock write paid for its seven indexes - only read by migratelocks
+        TABLE legacy_token_lock {
+            uint64_t    id;
+            name        lock_type;
+            name        sponsor;
+            name        beneficiary;
+            asset       quantity;
+            name        trigger_event;
+            name        trigger_source;
+            time_point  vesting_date;
+            string      notes;
+            time_point  created_date;
+            time_point  updated_date;
 
             uint64_t    primary_key()       const { return id; }  
             uint64_t    by_sponsor()        const { return sponsor.value; }
@@ -134,15 +168,15 @@ CONTRACT escrow : public contract {
             uint64_t    by_type()           const { return lock_type.value; }
         };
 
-        typedef eosio::multi_index<"locks"_n, token_lock,
-            indexed_by<"bysponsor"_n, const_mem_fun<token_lock, uint64_t, &token_lock::by_sponsor>>,
-            indexed_by<"bybneficiary"_n, const_mem_fun<token_lock, uint64_t, &token_lock::by_beneficiary>>,
-            indexed_by<"bycreated"_n, const_mem_fun<token_lock, uint64_t, &token_lock::by_created>>,
-            indexed_by<"byupdated"_n, const_mem_fun<token_lock, uint64_t, &token_lock::by_updated>>,
-            indexed_by<"byvesting"_n, const_mem_fun<token_lock, uint64_t, &token_lock::by_vesting>>,
-            indexed_by<"byevent"_n, const_mem_fun<token_lock, uint64_t, &token_lock::by_event>>,
-            indexed_by<"bytype"_n, const_mem_fun<token_lock, uint64_t, &token_lock::by_type>>
-        > token_lock_table;
+        typedef eosio::multi_index<"locks"_n, legacy_token_lock,
+            indexed_by<"bysponsor"_n, const_mem_fun<legacy_token_lock, uint64_t, &legacy_token_lock::by_sponsor>>,
+            indexed_by<"bybneficiary"_n, const_mem_fun<legacy_token_lock, uint64_t, &legacy_token_lock::by_beneficiary>>,
+            indexed_by<"bycreated"_n, const_mem_fun<legacy_token_lock, uint64_t, &legacy_token_lock::by_created>>,
+            indexed_by<"byupdated"_n, const_mem_fun<legacy_token_lock, uint64_t, &legacy_token_lock::by_updated>>,
+            indexed_by<"byvesting"_n, const_mem_fun<legacy_token_lock, uint64_t, &legacy_token_lock::by_vesting>>,
+            indexed_by<"byevent"_n, const_mem_fun<legacy_token_lock, uint64_t, &legacy_token_lock::by_event>>,
+            indexed_by<"bytype"_n, const_mem_fun<legacy_token_lock, uint64_t, &legacy_token_lock::by_type>>
+        > legacy_token_lock_table;
 
         // scoped by get_self()
         TABLE sponsors_table {
@@ -180,4 +214,7 @@ CONTRACT escrow : public contract {
         void check_asset(asset quantity);
         void deduct_from_sponsor(name sponsor, asset locked_quantity);
         void send_transfer(const name & beneficiary, const asset & quantity, const string & memo);
+        void check_locks_migrated();
+        std::pair<name, uint64_t> get_proposal(const string & notes);
+        void send_proposal_done(const name & proposal_contract, const uint64_t & proposal_id);
 };
@@ -45,12 +45,12 @@ CONTRACT forum : public contract {
 
         ACTION rankforums();
 
-        ACTION rankforum(uint64_t start, uint64_t chunksize, uint64_t chunk);
+        // start_rep / start_account: byrep key and account of the next row, name() to start from the beginning
+        // available_points > 0 also gives each ranked account its rep in the same pass
+        ACTION rankforum(uint64_t start_rep, name start_account, uint64_t current, uint64_t chunksize, uint64_t available_points);
 
         ACTION givereps();
 
-        ACTION giverep(uint64_t start, uint64_t chunksize, uint64_t available_points);
-
         ACTION delteactives();
 
         ACTION deleteactive(uint64_t chunksize);
@@ -194,6 +194,6 @@ CONTRACT forum : public contract {
 
 EOSIO_DISPATCH(forum, 
     (createpost)(createcomt)(upvotepost)(upvotecomt)(downvotepost)(downvotecomt)(reset)(onperiod)(newday)
-    (rankforums)(rankforum)(givereps)(giverep)(delteactives)(deleteactive)
+    (rankforums)(rankforum)(givereps)(delteactives)(deleteactive)
     (testapoints)(testsize)(testrank)
 );
@@ -8,6 +8,7 @@
 #include <tables/user_table.hpp>
 #include <tables/config_table.hpp>
 #include <tables/size_table.hpp>
+#include <map>
 
 using namespace eosio;
 using namespace utils;
@@ -23,6 +24,8 @@ CONTRACT gratitude : public contract {
       : contract(receiver, code, ds),
         balances(receiver, receiver.value),
         acks(receiver, receiver.value),
+        ackdonors(receiver, receiver.value),
+        ackcounts(receiver, receiver.value),
         stats(receiver, receiver.value),
         stats2(receiver, receiver.value),
         sizes(receiver, receiver.value),
@@ -44,7 +47,7 @@ CONTRACT gratitude : public contract {
     // Called after all acks are calculated
     ACTION payround(uint64_t start, uint64_t usable_bal);
 
-    // Recursivelly calculate acks
+    // Recursivelly calculate acks, start is unused and only kept for the action's signature
     ACTION calcacks(uint64_t start);
 
     // For stats migration
@@ -62,7 +65,18 @@ CONTRACT gratitude : public contract {
     void check_user(name account);
     void init_balances(name account);
     void reset_balances(name account);
-    void _calc_acks(name account);
+    struct balance_delta {
+      uint64_t given = 0;
+      uint64_t received = 0;
+    };
+
+    // changes from calculating a batch of acks, written once per batch
+    struct gratitude_deltas {
+      std::map<name, balance_delta> balances;
+      uint64_t volume = 0;
+      uint64_t num_transfers = 0;
+    };
+
     void add_gratitude(name account, asset quantity);
     void sub_gratitude(name account, asset quantity);
     uint64_t get_current_volume();
@@ -100,6 +114,7 @@ CONTRACT gratitude : public contract {
       uint64_t by_received() const { return received.amount; }
     };
 
+    // replaced by ackdonors / ackcounts, only read to calculate acks made before the upgrade
     TABLE acks_table {
       name donor;
       vector<name> receivers; // can have duplicates
@@ -107,6 +122,23 @@ CONTRACT gratitude : public contract {
       uint64_t primary_key() const { return donor.value; }
     };
 
+    TABLE ack_donor_table {
+      name donor;
+      uint64_t num_acks; // acks made by donor this round
+
+      uint64_t primary_key() const { return donor.value; }
+    };
+
+    TABLE ack_count_table {
+      uint64_t id;
+      name donor;
+      name receiver;
+      uint64_t count; // times donor acknowledged receiver this round
+
+      uint64_t primary_key() const { return id; }
+      uint128_t by_donor_receiver() const { return (uint128_t(donor.value) << 64) + receiver.value; }
+    };
+
     TABLE stats_table {
       uint64_t round_id;
       uint64_t num_transfers;
@@ -132,12 +164,24 @@ CONTRACT gratitude : public contract {
 
     typedef eosio::multi_index<"acks"_n, acks_table> acks_tables;
 
+    typedef eosio::multi_index<"ackdonors"_n, ack_donor_table> ack_donor_tables;
+
+    typedef eosio::multi_index<"ackcounts"_n, ack_count_table,
+        indexed_by<"bydonorrec"_n,
+        const_mem_fun<ack_count_table, uint128_t, &ack_count_table::by_donor_receiver>>
+    > ack_count_tables;
+
     typedef eosio::multi_index<"stats"_n, stats_table> stats_tables;
 
     typedef eosio::multi_index<"stats2"_n, stats_table_v2> stats_tables_v2;
 
+    uint64_t _calc_acks(name donor, uint64_t min_acks, gratitude_deltas & deltas);
+    void flush_gratitude(const gratitude_deltas & deltas);
+
     balance_tables balances;
     acks_tables acks;
+    ack_donor_tables ackdonors;
+    ack_count_tables ackcounts;
     stats_tables stats;
     stats_tables_v2 stats2;
 
@@ -150,6 +194,7 @@ CONTRACT gratitude : public contract {
     const name gratzgen_cit = "gratz2.gen"_n; // Gratitude generated per cycle for citizens
     const name gratz_acks = "gratz.acks"_n; // Gratitude generated per cycle for citizens
     const name gratz_potkp = "gratz.potkp"_n; // Percentil of the pot to keep each round
+    const name gratz_budget = "gratz.budget"_n; // Max acks calculated per calcacks transaction
 };
 
 extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) {
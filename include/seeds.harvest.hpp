@@ -18,6 +18,7 @@
 #include <tables/organization_table.hpp>
 #include <eosio/singleton.hpp>
 #include <tables/dho_share_table.hpp>
+#include <benchmark.hpp>
 #include <cmath>
 #include <variant>
 
@@ -84,6 +85,10 @@ CONTRACT harvest : public contract {
     ACTION rankcss(); // rank contribution score //
     ACTION rankorgcss();
     ACTION rankcs(uint64_t start_val, uint64_t chunk, uint64_t chunksize, name cs_scope);
+    ACTION mergecs(name cs_scope, uint64_t chunksize);
+
+    ACTION rankalls(); // fused planted rank, tx rank, contribution points and cs rank // 1h interval
+    ACTION rankall(uint64_t chunksize);
 
     ACTION rankrgncss();
     ACTION rankrgncs(uint64_t start, uint64_t chunk, uint64_t chunksize);
@@ -96,6 +101,9 @@ CONTRACT harvest : public contract {
     ACTION testclaim(name from, uint64_t request_id, uint64_t sec_rewind);
     ACTION testupdatecs(name account, uint64_t contribution_score);
     ACTION testcspoints(name account, uint64_t contribution_points);
+#ifdef SEEDS_BENCHMARK
+    ACTION testseed(uint64_t start, uint64_t count);
+#endif
     
     ACTION setorgtxpt(name organization, uint64_t tx_points);
 
@@ -134,6 +142,14 @@ CONTRACT harvest : public contract {
     name cs_rgn_size = "rgn.cs.sz"_n;
     name cs_org_size = "org.cs.sz"_n;
 
+    const name rank_phase_planted_tx = "plantedtx"_n;
+    const name rank_phase_calc_cs = "calccs"_n;
+    const name rank_phase_rank_cs = "rankcs"_n;
+    const name rank_phase_done = "done"_n;
+
+    // synthetic accounts created by testseed are bench_account_base + index
+    const name bench_account_base = "bench"_n;
+
     const name individual_scope_accounts = contracts::accounts;
     const name individual_scope_harvest = get_self();
     const name organization_scope = "org"_n;
@@ -153,6 +169,8 @@ CONTRACT harvest : public contract {
     void change_total(bool add, asset quantity);
     void calc_contribution_score(name account, name type);
     void add_cs_to_region(name account, uint32_t points);
+    void set_cs_points(name account, name cs_scope, uint64_t contribution_points);
+    void send_merge_cs(name cs_scope, uint64_t chunksize);
 
     void size_change(name id, int delta);
     void size_set(name id, uint64_t newsize);
@@ -163,6 +181,7 @@ CONTRACT harvest : public contract {
     void send_distribute_harvest (name key, asset amount);
     void withdraw_aux(name sender, name beneficiary, asset quantity, string memo);
     void send_pool_payout(asset quantity);
+    int64_t get_pool_balance();
     void log_send_distribute_harvest (name key, asset amount, uint64_t log_group, uint64_t batch_size);
 
     // Contract Tables
@@ -266,6 +285,20 @@ CONTRACT harvest : public contract {
 
     DEFINE_SIZE_TABLE_MULTI_INDEX
 
+    DEFINE_RANK_LOCK_TABLE
+
+    DEFINE_RANK_LOCK_TABLE_MULTI_INDEX
+
+    // contribution points calculated while rankcs walks the scope, merged by mergecs
+    TABLE cs_pending_table { // scoped by cs scope
+      name account;
+      uint32_t contribution_points;
+
+      uint64_t primary_key() const { return account.value; }
+    };
+
+    typedef eosio::multi_index<"cspending"_n, cs_pending_table> cs_pending_tables;
+
     // DEPRECATED - REMOVE ONCE APPS ARE UPDATED // 
     DEFINE_HARVEST_TABLE
     
@@ -315,6 +348,25 @@ CONTRACT harvest : public contract {
     > region_tables;
 
 
+    // Cursor of the fused ranking chain - one row, advanced by each rankall chunk
+    TABLE rank_cursor_table {
+      name phase;
+      uint64_t chunk;
+      uint128_t planted_start;
+      uint64_t planted_current;
+      uint64_t planted_total;
+      uint64_t tx_start;
+      uint64_t tx_current;
+      uint64_t tx_total;
+      uint64_t users_start;
+      uint64_t cs_start;
+      uint64_t cs_current;
+      uint64_t cs_total;
+    };
+
+    typedef singleton<"rankcursor"_n, rank_cursor_table> rank_cursor_tables;
+    typedef eosio::multi_index<"rankcursor"_n, rank_cursor_table> dump_for_rank_cursor;
+
     TABLE total_table {
       uint64_t id;
       asset total_planted;
@@ -340,6 +392,15 @@ CONTRACT harvest : public contract {
       uint64_t by_points() const { return points; }
     };
 
+    // From history contract
+    TABLE trx_window_table {
+      name account;
+      uint64_t points;
+      uint64_t window_start;
+
+      uint64_t primary_key() const { return account.value; }
+    };
+
     // From history contract
     TABLE qev_table { // scoped by account
       uint64_t timestamp;
@@ -380,6 +441,8 @@ CONTRACT harvest : public contract {
       const_mem_fun<transaction_points_table, uint64_t, &transaction_points_table::by_points>>
     > transaction_points_tables;
 
+    typedef eosio::multi_index<"trxwindow"_n, trx_window_table> trx_window_tables;
+
     typedef eosio::multi_index<"qevs"_n, qev_table,
       indexed_by<"byvolume"_n,
       const_mem_fun<qev_table, uint64_t, &qev_table::by_volume>>
@@ -459,6 +522,13 @@ CONTRACT harvest : public contract {
 
 };
 
+// benchmark only actions are left out of the contract unless it is compiled with BENCHMARK=1 (see scripts/compile.js)
+#ifdef SEEDS_BENCHMARK
+#define HARVEST_BENCHMARK_ACTIONS (testseed)
+#else
+#define HARVEST_BENCHMARK_ACTIONS
+#endif
+
 extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) {
   if (action == name("transfer").value && code == contracts::token.value) {
       execute_action<harvest>(name(receiver), name(code), &harvest::plant);
@@ -467,10 +537,10 @@ extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) {
           EOSIO_DISPATCH_HELPER(harvest, 
           (payforcpu)(reset)
           (unplant)(claimrefund)(cancelrefund)(sow)
-          (ranktx)(calctrxpt)(calctrxpts)(rankplanted)(rankplanteds)(calccss)(calccs)(rankcss)(rankorgcss)(rankcs)(ranktxs)(rankorgtxs)(updatecs)(rankrgncss)(rankrgncs)
+          (ranktx)(calctrxpt)(calctrxpts)(rankplanted)(rankplanteds)(calccss)(calccs)(rankcss)(rankorgcss)(rankcs)(mergecs)(ranktxs)(rankorgtxs)(updatecs)(rankalls)(rankall)(rankrgncss)(rankrgncs)
           (updatetxpt)(calctotal)
           (setorgtxpt)
-          (testclaim)(testupdatecs)(testcalcmqev)(testcspoints)
+          (testclaim)(testupdatecs)(testcalcmqev)(testcspoints) HARVEST_BENCHMARK_ACTIONS
           (calcmqevs)(calcmintrate)
           (runharvest)(disthvstusrs)(disthvstorgs)(disthvstrgns)(disthvstdhos)
           (logaction)(lgcalcmqevs)(lgrunhrvst)(lgcalmntrte)(resetlogs)(resetlgroups)
@@ -12,6 +12,7 @@
 #include <tables/user_table.hpp>
 
 #include <cmath>
+#include <map>
 
 using namespace eosio;
 using std::string;
@@ -28,6 +29,8 @@ CONTRACT history : public contract {
           citizens(receiver, receiver.value),
           totals(receiver, receiver.value),
           trxcbprewards(receiver, receiver.value),
+          trxqueue(receiver, receiver.value),
+          trxwindows(receiver, receiver.value),
           organizations(contracts::organization, contracts::organization.value),
           members(contracts::region, contracts::region.value)
         {}
@@ -37,6 +40,8 @@ CONTRACT history : public contract {
         ACTION historyentry(name account, string action, uint64_t amount, string meta);
 
         ACTION trxentry(name from, name to, asset quantity);
+
+        ACTION trxentries(name from, std::vector<name> to, std::vector<asset> quantities);
         
         ACTION addcitizen(name account);
         
@@ -54,6 +59,11 @@ CONTRACT history : public contract {
 
         ACTION updatetxpt(uint64_t deferred_id, name from);
 
+        ACTION savetrxs();
+
+        ACTION expiretrxs();
+        ACTION expiretrx(uint64_t start, uint64_t chunksize);
+
         ACTION cleanptrxs();
 
         ACTION testtotalqev(uint64_t numdays, uint64_t volume);
@@ -87,12 +97,25 @@ CONTRACT history : public contract {
       void fire_orgtx_calc(name organization, uint128_t start_val, uint64_t chunksize, uint64_t running_total);
       bool clean_old_tx(name org, uint64_t chunksize);
       void save_from_metrics (name from, int64_t & from_points, int64_t & qualifying_volume, uint64_t & day);
+      void save_trx_points(name account, uint64_t day, int64_t points);
+      uint64_t trx_window_cutoff();
       void send_update_txpoints (name from);
       double config_float_get(name key);
       double get_transaction_multiplier(name account, name other);
       void send_trx_cbp_reward_action(name from, name to);
       void send_add_cbs(name account, int points);
       void trx_cbp_reward(name account, name key);
+      void send_cbp_rewards(name from, name to);
+      void send_save_trxs();
+      void add_trx_entry(
+        name from, 
+        bool from_is_organization, 
+        name to, 
+        asset quantity, 
+        int64_t transactions_cap, 
+        int64_t max_transaction_points_individuals, 
+        int64_t max_transaction_points_organizations
+      );
       
       // migration functions
       void save_migration_user_transaction(name from, name to, asset quantity, uint64_t timestamp);
@@ -205,6 +228,14 @@ CONTRACT history : public contract {
         uint64_t by_points() const { return points; }
       };
 
+      TABLE trx_window_table { // sum of trxpoints rows with timestamp >= window_start
+        name account;
+        uint64_t points;
+        uint64_t window_start;
+
+        uint64_t primary_key() const { return account.value; }
+      };
+
       TABLE qev_table { // scoped by account
         uint64_t timestamp;
         uint64_t qualifying_volume;
@@ -255,6 +286,17 @@ CONTRACT history : public contract {
         uint128_t by_account_key() const { return (uint128_t(account.value) << 64) + key.value; }
       };
 
+      TABLE trx_queue_table { // transfers waiting for savetrxs
+        uint64_t id;
+        uint64_t day;
+        uint64_t transaction_id;
+        name from;
+        name to;
+        uint64_t volume;
+
+        uint64_t primary_key() const { return id; }
+      };
+
       TABLE deferred_id_table {
         uint64_t id;
       };
@@ -297,6 +339,8 @@ CONTRACT history : public contract {
         const_mem_fun<transaction_points_table, uint64_t, &transaction_points_table::by_points>>
       > transaction_points_tables;
 
+      typedef eosio::multi_index<"trxwindow"_n, trx_window_table> trx_window_tables;
+
       typedef eosio::multi_index<"qevs"_n, qev_table,
         indexed_by<"byvolume"_n,
         const_mem_fun<qev_table, uint64_t, &qev_table::by_volume>>
@@ -313,6 +357,8 @@ CONTRACT history : public contract {
         indexed_by<"byregion"_n,const_mem_fun<members_table, uint64_t, &members_table::by_region>>
       > members_tables;
 
+      typedef eosio::multi_index<"trxqueue"_n, trx_queue_table> trx_queue_tables;
+
       typedef eosio::multi_index<"trxcbpreward"_n, trx_cbp_rewards_table,
         indexed_by<"byacctkey"_n,
         const_mem_fun<trx_cbp_rewards_table, uint128_t, &trx_cbp_rewards_table::by_account_key>>
@@ -334,17 +380,21 @@ CONTRACT history : public contract {
       organization_tables organizations;
       members_tables members;
       trx_cbp_rewards_tables trxcbprewards;
+      trx_queue_tables trxqueue;
+      trx_window_tables trxwindows;
 };
 
 EOSIO_DISPATCH(history, 
   (reset)
-  (historyentry)(trxentry)
+  (historyentry)(trxentry)(trxentries)
   (addcitizen)(addresident)
   (updatestatus)
   (numtrx)
   (deldailytrx)(savepoints)
   (testtotalqev)
   (sendtrxcbp)(updatetxpt)
+  (savetrxs)
+  (expiretrxs)(expiretrx)
   (cleanptrxs)
   (migrateusers)(migrateuser)
   (migrate)(testptrx)
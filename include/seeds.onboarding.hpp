@@ -38,6 +38,8 @@ public:
   ACTION acceptnew(name account, checksum256 invite_secret, string publicKey, string fullname);
   ACTION acceptexist(name account, checksum256 invite_secret); // TODO: Remove, use "reward" instead
   ACTION reward(name account, checksum256 invite_secret);
+  // accept many invites creating new accounts (account, invite_secret, publicKey, fullname) - needs the application key
+  ACTION acceptbatch(std::vector<std::tuple<name, checksum256, string, string>> invites);
   ACTION onboardorg(name sponsor, name account, string fullname, string publicKey);
   ACTION createregion(name sponsor, name region, string publicKey);
 
@@ -65,11 +67,23 @@ private:
   bool is_seeds_user(name account);
   void add_user(name account, string fullname, name type);
   void transfer_seeds(name account, asset quantity, string memo);
-  void plant_seeds(asset quantity);
   void sow_seeds(name account, asset quantity);
   void add_referral(name sponsor, name account);
-  void invitevouch(name sponsor, name account);
+
+  struct accepted_invite {
+    name account;
+    name referrer;
+    string fullname;
+    bool is_new_seeds_user;
+    uint64_t invite_id;
+    asset transfer_quantity;
+    asset sow_quantity;
+  };
+
   void accept_invite(name account, checksum256 invite_secret, string publicKey, string fullname, bool is_existing_telos_account, bool is_plant_seeds);
+  accepted_invite use_invite(name account, checksum256 invite_secret, string publicKey, string fullname, bool is_existing_telos_account);
+  void onboard_users(const std::vector<accepted_invite> & accepted);
+  void pay_invite(const accepted_invite & accepted, bool is_plant_seeds);
   void _invite(name sponsor, name referrer, asset transfer_quantity, asset sow_quantity, checksum256 invite_hash, uint64_t campaign_id);
   void check_user(name account);
   uint64_t config_get(name key);
@@ -206,7 +220,7 @@ extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action)
   {
     switch (action)
     {
-      EOSIO_DISPATCH_HELPER(onboarding, (reset)(invite)(invitefor)(accept)(onboardorg)(createregion)(acceptnew)(acceptexist)(reward)(cancel)(chkcleanup)(cleanup)(createcampg)(campinvite)(addauthorized)(remauthorized)(returnfunds)(rtrnfundsaux))
+      EOSIO_DISPATCH_HELPER(onboarding, (reset)(invite)(invitefor)(accept)(onboardorg)(createregion)(acceptnew)(acceptexist)(reward)(acceptbatch)(cancel)(chkcleanup)(cleanup)(createcampg)(campinvite)(addauthorized)(remauthorized)(returnfunds)(rtrnfundsaux))
     }
   }
 }
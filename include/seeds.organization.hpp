@@ -22,6 +22,7 @@ CONTRACT organization : public contract {
               sponsors(receiver, receiver.value),
               apps(receiver, receiver.value),
               dausscores(receiver, receiver.value),
+              dauswindow(receiver, receiver.value),
               regenscores(receiver, receiver.value),
               cbsorgs(receiver, receiver.value),
               sizes(receiver, receiver.value),
@@ -71,6 +72,11 @@ CONTRACT organization : public contract {
 
         ACTION rankappuse(uint128_t start, uint64_t chunk, uint64_t chunksize);
 
+        ACTION cleandaus();
+
+        // deletes daus / daustotals rows older than the trailing window, at most chunksize rows per call
+        ACTION cleandau(uint64_t start, uint64_t chunksize, uint64_t cutoff);
+
         ACTION rankregens();
 
         ACTION rankregen(uint64_t start, uint64_t chunk, uint64_t chunksize);
@@ -271,6 +277,16 @@ CONTRACT organization : public contract {
             uint64_t primary_key() const { return day; }
         };
 
+        // sum of daustotals from start_day on, kept up to date by appuse
+        TABLE daus_window_table {
+            name app_name;
+            int64_t points;
+            uint64_t users;
+            uint64_t start_day;
+
+            uint64_t primary_key() const { return app_name.value; }
+        };
+
         TABLE daus_score {
             name app_name;
             int64_t total_points;
@@ -353,6 +369,8 @@ CONTRACT organization : public contract {
 
         typedef eosio::multi_index<"daustotals"_n, daus_totals_table> daus_totals_tables;
 
+        typedef eosio::multi_index<"dauswindow"_n, daus_window_table> daus_window_tables;
+
         typedef eosio::multi_index<"dausscores"_n, daus_score,
             indexed_by<"bytpoints"_n,
             const_mem_fun<daus_score, uint64_t, &daus_score::by_total_points>>,
@@ -396,6 +414,7 @@ CONTRACT organization : public contract {
         config_tables config;
         app_tables apps;
         daus_scores dausscores;
+        daus_window_tables dauswindow;
         regen_score_tables regenscores;
         cbs_organization_tables cbsorgs;
         size_tables sizes;
@@ -424,6 +443,8 @@ CONTRACT organization : public contract {
         void check_status_requirements(name organization, uint64_t status);
         void history_update_org_status(name organization, uint64_t status);
         void calculate_trailing_app_use(const name & appname, const uint64_t & cutoff, const int64_t & threshold);
+        void expire_daus_window(const name & appname, const uint64_t & cutoff);
+        uint64_t get_daus_cutoff();
 };
 
 
@@ -434,7 +455,7 @@ extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) {
       switch (action) {
           EOSIO_DISPATCH_HELPER(organization, (reset)(addmember)(removemember)(changerole)(changeowner)(addregen)
             (subregen)(create)(destroy)(refund)
-            (appuse)(registerapp)(banapp)(calcmappuses)(calcmappuse)(rankappuses)(rankappuse)
+            (appuse)(registerapp)(banapp)(calcmappuses)(calcmappuse)(rankappuses)(rankappuse)(cleandaus)(cleandau)
             (rankregens)(rankregen)(scoreorgs)(scoretrxs)
             (makethrivble)(makeregen)(makesustnble)(makereptable)(testregensc)(teststatus))
       }
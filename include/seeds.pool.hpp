@@ -1,10 +1,13 @@
 #include <eosio/eosio.hpp>
 #include <eosio/asset.hpp>
 #include <eosio/transaction.hpp>
+#include <eosio/singleton.hpp>
+#include <eosio/binary_extension.hpp>
 #include <contracts.hpp>
 #include <utils.hpp>
 #include <tables/config_table.hpp>
 #include <tables/size_table.hpp>
+#include <cmath>
 
 using namespace eosio;
 using std::string;
@@ -18,6 +21,7 @@ CONTRACT pool : public contract {
       : contract(receiver, code, ds),
         balances(receiver, receiver.value),
         sizes(receiver, receiver.value),
+        payoutstate(receiver, receiver.value),
         config(contracts::settings, contracts::settings.value)
         {}
 
@@ -27,7 +31,10 @@ CONTRACT pool : public contract {
 
     ACTION payouts(asset quantity);
 
-    ACTION payout(asset quantity, uint64_t start, uint64_t chunksize, int64_t old_total_balance);
+    // background pass that settles every holder, payouts does not start it - run it rarely
+    ACTION settle(uint64_t start, uint64_t chunksize);
+
+    ACTION claim(name account);
 
     ACTION transfer(name from, name to, asset quantity, const string& memo);
 
@@ -35,8 +42,12 @@ CONTRACT pool : public contract {
   private:
 
     const name total_balance_size = "total.sz"_n;
+    const name unsettled_size = "unsettled.sz"_n; // paid out by payouts, not transferred to holders yet
 
     void send_transfer(const name & to, const asset & quantity, const string & memo);
+    void send_settle(uint64_t start, uint64_t chunksize);
+    void settle_account(const name & account);
+    int64_t settle_balance(const name & account);
     void update_pool_token( const name& owner, const asset& quantity, const symbol sym = utils::pool_symbol);
     void add_balance( const name& owner, const asset& value, const name& ram_payer );
     bool sub_balance( const name& owner, const asset& value );
@@ -53,11 +64,21 @@ CONTRACT pool : public contract {
 
     TABLE balances_table {
       name account;
-      asset balance;
+      asset balance; // as of the last time the account was settled
+      eosio::binary_extension<double> payout_index;
+      eosio::binary_extension<uint64_t> payout_epoch;
 
       uint64_t primary_key () const { return account.value; }
     };
 
+    // Every payout of quantity out of total adds log(total / (total - quantity)) to index, so a balance
+    // settled at payout_index is owed balance * (1 - exp(payout_index - index)).
+    // Paying out the whole pool starts a new epoch, balances from an earlier epoch are owed in full.
+    TABLE payout_state_table {
+      uint64_t epoch;
+      double index;
+    };
+
     TABLE account {
       asset    balance;
 
@@ -67,8 +88,12 @@ CONTRACT pool : public contract {
     typedef eosio::multi_index<"balances"_n, balances_table> balances_tables;
     typedef eosio::multi_index< "accounts"_n, account > accounts;
 
+    typedef singleton<"payoutstate"_n, payout_state_table> payout_state_tables;
+    typedef eosio::multi_index<"payoutstate"_n, payout_state_table> dump_for_payout_state;
+
     balances_tables balances;
     size_tables sizes;
+    payout_state_tables payoutstate;
 
     // external tables
     config_tables config;
@@ -82,7 +107,7 @@ extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) {
       switch (action) {
         EOSIO_DISPATCH_HELPER(pool, 
           (reset)
-          (payouts)(payout)(transfer)
+          (payouts)(settle)(claim)(transfer)
         )
       }
   }
@@ -2,6 +2,7 @@
 #include <eosio/eosio.hpp>
 #include <eosio/transaction.hpp>
 #include <eosio/singleton.hpp>
+#include <eosio/binary_extension.hpp>
 #include <seeds.token.hpp>
 #include <contracts.hpp>
 #include <utils.hpp>
@@ -86,8 +87,6 @@ CONTRACT proposals : public contract {
 
       ACTION decayvoices();
 
-      ACTION decayvoice(uint64_t start, uint64_t chunksize);
-
       ACTION testquorum(uint64_t total_proposals);
       ACTION testvn(uint64_t total_voice, uint64_t num_proposals);
 
@@ -209,6 +208,8 @@ CONTRACT proposals : public contract {
       name get_scope(name fund);
       bool has_delegates(name voter, name scope);
 
+      uint64_t voice_balance (const voice_table & v, name scope);
+      void stamp_voice (voice_table & v, name scope);
       double voice_change (name user, uint64_t amount, bool reduce, name scope);
       void set_voice (name user, uint64_t amount, name scope);
       void erase_voice (name user);
@@ -337,9 +338,12 @@ CONTRACT proposals : public contract {
         uint64_t primary_key()const { return account.value; }
       };
 
+      // balance is as of decay_index / decay_epoch, use voice_balance to read it
       TABLE voice_table {
         name account;
         uint64_t balance;
+        eosio::binary_extension<double> decay_index;
+        eosio::binary_extension<uint64_t> decay_epoch;
         uint64_t primary_key()const { return account.value; }
       };
 
@@ -353,6 +357,8 @@ CONTRACT proposals : public contract {
         uint64_t propcycle; 
         uint64_t t_onperiod; // last time onperiod ran
         uint64_t t_voicedecay; // last time voice was decayed
+        eosio::binary_extension<double> decay_index; // sum of -log(1 - decay) over all decays
+        eosio::binary_extension<uint64_t> decay_epoch; // bumped by a 100% decay, older voice is 0
       };
 
       TABLE active_table {
@@ -472,7 +478,7 @@ extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) {
   } else if (code == receiver) {
       switch (action) {
         EOSIO_DISPATCH_HELPER(proposals, (reset)(create)(createx)(createinvite)(update)(updatex)(addvoice)(changetrust)(favour)(against)
-        (neutral)(erasepartpts)(checkstake)(onperiod)(evalproposal)(decayvoice)(cancel)(updatevoices)(updatevoice)(decayvoices)
+        (neutral)(erasepartpts)(checkstake)(onperiod)(evalproposal)(cancel)(updatevoices)(updatevoice)(decayvoices)
         (addactive)(testvdecay)(initsz)(testquorum)(initnumprop)
         (questvote)
         (testsetvoice)(delegate)(mimicvote)(undelegate)(voteonbehalf)
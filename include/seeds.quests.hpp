@@ -15,7 +15,9 @@
 #include <graph_common.hpp>
 #include <document_graph/content.hpp>
 #include <document_graph/document.hpp>
+#include <document_graph/variable_document.hpp>
 #include <document_graph/edge.hpp>
+#include <document_graph/edge_cache.hpp>
 #include <document_graph/util.hpp>
 #include <document_graph/content_wrapper.hpp>
 #include <document_graph/document_graph.hpp>
@@ -98,6 +100,14 @@ CONTRACT quests : public contract {
 
     ACTION ratequest(checksum256 quest_hash, name opinion);
 
+    ACTION migrateedges(uint64_t chunksize);
+
+    ACTION testlgcyedge(checksum256 from_node, checksum256 to_node, name edge_name);
+
+#ifdef SEEDS_BENCHMARK
+    ACTION testhashdoc(uint64_t num_contents);
+#endif
+
 
   private:
 
@@ -150,18 +160,18 @@ CONTRACT quests : public contract {
     void check_quest_status_stage(hypha::ContentWrapper & cw, const name & status, const name & stage, const string & error_msg);
     void check_quest_status_stage(const checksum256 & quest_hash, const name & status, const name & stage, const string & error_msg);
     void validate_milestones(const checksum256 & quest_hash);
-    void update_balance(hypha::Document & balance_doc, asset & quantity, const bool & substract);
-    void add_balance(hypha::Document & balance_doc, asset & quantity);
-    void sub_balance(hypha::Document & balance_doc, asset & quantity);
+    void update_balance(hypha::VariableDocument & balance_doc, asset & quantity, const bool & substract);
+    void add_balance(hypha::VariableDocument & balance_doc, asset & quantity);
+    void sub_balance(hypha::VariableDocument & balance_doc, asset & quantity);
     void check_user(name & account);
-    void update_milestone_status(hypha::Document * milestone_v_doc, const name & new_status, const name & check_status);
+    void update_milestone_status(hypha::VariableDocument * milestone_v_doc, const name & new_status, const name & check_status);
     void send_to_escrow(const name & fromfund, const name & recipient, asset & quantity, const string & memo);
-    void update_node(hypha::Document * node_doc, const string & content_group_label, const std::vector<hypha::Content> & new_contents);
+    void update_node(hypha::VariableDocument * node_doc, const string & content_group_label, const std::vector<hypha::Content> & new_contents);
     void propose_aux(const checksum256 & node_hash, const name & quest_owner, const name & passed_action, const name & rejected_action);
     void proposal_quest_aux(hypha::Document & quest_doc);
     void vote_aux(name & voter, const checksum256 & proposal_hash, int64_t & amount, const name & option);
     void check_auth(name & creator, name & fund);
-    void accept_milestone(hypha::Document & milestone_doc, hypha::Document & milestone_v_doc);
+    void accept_milestone(hypha::Document & milestone_doc, hypha::VariableDocument & milestone_v_doc);
     
     int64_t active_cutoff_date();
     bool is_active(hypha::ContentWrapper & account_info_v_cw, int64_t & cutoff_date);
@@ -170,7 +180,7 @@ CONTRACT quests : public contract {
     hypha::Document get_root_node();
     hypha::Document get_account_infos_node();
     hypha::Document get_proposals_node ();
-    hypha::Document get_variable_node_or_fail(hypha::Document & fixed_node);
+    hypha::VariableDocument get_variable_node_or_fail(hypha::Document & fixed_node);
     hypha::Document get_account_info(name & account, const bool & create_if_not_exists);
     hypha::Document get_quest_node_from_milestone(hypha::Document & milestone_doc);
     bool edge_exists(const checksum256 & from_node_hash, const name & edge_name);
@@ -207,6 +217,13 @@ CONTRACT quests : public contract {
 
 };
 
+// benchmark only actions are left out of the contract unless it is compiled with BENCHMARK=1 (see scripts/compile.js)
+#ifdef SEEDS_BENCHMARK
+#define QUESTS_BENCHMARK_ACTIONS (testhashdoc)
+#else
+#define QUESTS_BENCHMARK_ACTIONS
+#endif
+
 extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) {
   if (action == name("transfer").value && code == contracts::token.value) {
       execute_action<quests>(name(receiver), name(code), &quests::stake);
@@ -219,6 +236,7 @@ extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) {
           (expirequest)(expireappl)(cancelappl)(retractappl)(quitapplcnt)
           (evalprop)(favour)(against)
           (rateapplcnt)(ratequest)
+          (migrateedges)(testlgcyedge) QUESTS_BENCHMARK_ACTIONS
         )
       }
   }
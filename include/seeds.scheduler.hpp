@@ -1,9 +1,11 @@
 #include <eosio/eosio.hpp>
 #include <eosio/system.hpp>
+#include <eosio/binary_extension.hpp>
 #include <contracts.hpp>
 #include <utils.hpp>
 #include <tables/config_table.hpp>
 #include <tables/moon_phases_table.hpp>
+#include <limits>
 
 using namespace eosio;
 using std::string;
@@ -53,16 +55,24 @@ CONTRACT scheduler : public contract {
         
         ACTION checknext();
 
+        // run once after deploying the bynextdue indexes, rewrites every op so its index key is its real due time
+        ACTION reindexops();
+
     private:
         void exec_op(name id, name contract, name action);
         void cancel_exec();
         void reset_aux(bool destructive);
         uint64_t next_valid_moon_phase(uint64_t moon_cycle_id, uint64_t quarter_moon_cycles);
+        uint64_t moon_op_due_time(const uint64_t & start_time, const uint64_t & last_moon_cycle_id, const uint64_t & quarter_moon_cycles);
+        uint64_t next_due_time();
         bool should_preserve_op(name op_id) {
             return 
                 op_id == "exch.period"_n || 
                 op_id == "tokn.resetw"_n;
         }
+        bool should_start_paused(name op_id) {
+            return op_id == "hrvst.rankal"_n;
+        }
 
         TABLE operations_table {
             name id;
@@ -73,7 +83,7 @@ CONTRACT scheduler : public contract {
             uint64_t timestamp;
 
             uint64_t primary_key() const { return id.value; }
-            uint64_t by_timestamp() const { return timestamp; }
+            uint64_t by_next_due() const { return pause > 0 ? std::numeric_limits<uint64_t>::max() : timestamp + period; }
         };
 
         DEFINE_MOON_PHASES_TABLE
@@ -87,9 +97,11 @@ CONTRACT scheduler : public contract {
             uint64_t start_time;
             uint64_t last_moon_cycle_id;
             uint8_t pause;
+            eosio::binary_extension<uint64_t> next_due; // max while the due moon phase is not in moonphases yet
 
             uint64_t primary_key() const { return id.value; }
-            uint64_t by_last_cycle() const { return last_moon_cycle_id; }
+            // rows from before next_due was added read as 0 and get their due time on the next execute
+            uint64_t by_next_due() const { return pause > 0 ? std::numeric_limits<uint64_t>::max() : next_due.value_or(0); }
         };
 
         TABLE test_table {
@@ -102,20 +114,23 @@ CONTRACT scheduler : public contract {
         
         DEFINE_CONFIG_TABLE_MULTI_INDEX
 
+        // bynextdue took the place of bytimestamp / bylastcycle, rows written before it keep their
+        // old key until reindexops rewrites them
         typedef eosio::multi_index < "operations"_n, operations_table,
-            indexed_by<"bytimestamp"_n, 
-            const_mem_fun<operations_table, uint64_t, &operations_table::by_timestamp>>
+            indexed_by<"bynextdue"_n, 
+            const_mem_fun<operations_table, uint64_t, &operations_table::by_next_due>>
         > operations_tables;
 
 
         typedef eosio::multi_index <"moonops"_n, moon_ops_table,
-            indexed_by<"bylastcycle"_n,
-            const_mem_fun<moon_ops_table, uint64_t, &moon_ops_table::by_last_cycle>>
+            indexed_by<"bynextdue"_n,
+            const_mem_fun<moon_ops_table, uint64_t, &moon_ops_table::by_next_due>>
         > moon_ops_tables;
 
         typedef eosio::multi_index <"test"_n, test_table> test_tables;
 
         name seconds_to_execute = "secndstoexec"_n;
+        name ops_per_execution = "sched.batch"_n;
 
         operations_tables operations;
         config_tables config;
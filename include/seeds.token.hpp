@@ -13,6 +13,7 @@
 #include <eosio/singleton.hpp>
 
 #include <string>
+#include <map>
 
 namespace eosiosystem {
    class system_contract;
@@ -109,6 +110,28 @@ namespace eosio {
                         const asset&   quantity,
                         const string&  memo );
 
+         struct transfer_entry {
+            name     to;
+            asset    quantity;
+            string   memo;
+         };
+
+         /**
+          * Transfer many action.
+          *
+          * @details Moves the same balances as calling transfer from `from` once per entry in `transfers`,
+          * but the sender's balance, transaction limit and transaction stats are read and written once per
+          * batch, and history gets a single trxentries call.
+          *
+          * Recipients are notified of transfermany, not transfer: `transfer` notify handlers in receiving
+          * contracts and off-chain trackers that only watch transfer actions do not see these payouts.
+          *
+          * @param from - the account to transfer from,
+          * @param transfers - the recipients, quantities and memos.
+          */
+         [[eosio::action]]
+         void transfermany( const name& from, const std::vector<transfer_entry>& transfers );
+
          /**
           * Open action.
           *
@@ -187,6 +210,7 @@ namespace eosio {
          using retire_action = eosio::action_wrapper<"retire"_n, &token::retire>;
          using burn_action = eosio::action_wrapper<"burn"_n, &token::burn>;
          using transfer_action = eosio::action_wrapper<"transfer"_n, &token::transfer>;
+         using transfermany_action = eosio::action_wrapper<"transfermany"_n, &token::transfermany>;
          using open_action = eosio::action_wrapper<"open"_n, &token::open>;
          using close_action = eosio::action_wrapper<"close"_n, &token::close>;
          using mint_action = eosio::action_wrapper<"minthrvst"_n, &token::minthrvst>;
@@ -237,10 +261,12 @@ namespace eosio {
          void sub_balance( const name& owner, const asset& value );
          void add_balance( const name& owner, const asset& value, const name& ram_payer );
          void update_stats( const name& from, const name& to, const asset& quantity );
+         void update_stats_many( const name& from, const std::vector<transfer_entry>& transfers );
          void save_transaction(name from, name to, asset quantity);
+         void save_transactions(name from, const std::vector<transfer_entry>& transfers);
          void check_limit( const name& from );
          uint64_t balance_for( const name& owner );
-         void check_limit_transactions(name from);
+         void check_limit_transactions(name from, uint64_t count = 1);
          void reset_weekly_aux(uint64_t begin);
 
          TABLE circulating_supply_table {
@@ -0,0 +1,15 @@
+#include <eosio/eosio.hpp>
+
+using eosio::name;
+
+// A row exists while a ranking chain walks the table for that scope.
+// timestamp is refreshed by every chunk - a lock that has not been refreshed
+// for rank_lock_timeout seconds belongs to a dead chain and is ignored.
+#define DEFINE_RANK_LOCK_TABLE TABLE rank_lock_table { \
+        name scope; \
+        uint64_t timestamp; \
+\
+        uint64_t primary_key()const { return scope.value; } \
+      };
+
+#define DEFINE_RANK_LOCK_TABLE_MULTI_INDEX typedef eosio::multi_index<"ranklocks"_n, rank_lock_table> rank_lock_tables;
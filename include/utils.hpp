@@ -8,6 +8,7 @@
 #include <tables/config_table.hpp>
 #include <tables/config_float_table.hpp>
 #include <tables/deferred_id_table.hpp>
+#include <tables/rank_lock_table.hpp>
 
 using namespace eosio;
 using std::string;
@@ -22,27 +23,16 @@ namespace utils {
   symbol seeds_symbol = symbol("SEEDS", 4);
   symbol pool_symbol = symbol("HPOOL", 4);
 
+  // seconds without progress after which a ranking chain's table lock is considered dead
+  const uint64_t rank_lock_timeout = seconds_per_minute * 10;
+
   inline uint64_t linear_rank(uint64_t current, uint64_t total) { 
     /**
-     * TODO - Table Locks
-     * 
-     * rank can exceed 99 when we count accounts double. This can happen when an account receives reputation while we iterate
-     * and is moved to a new bucket.
-     * We then count it again in this new bucket - this means we end up counting more users than are in the reps table
-     * which skews the count.
-     * The reason this is not atomic is that we go over the table in chunks, so inbetween chunks anything can happen.
-     * 
-     * The correct way to solve this would be to wait until the ranking is finished, and to apply changes in reputation only once that has
-     * happened. Like a manually implemented table lock. (rep or any other number we are ranking)
-     * 
-     * For now that's too complex - a lock would have to be between changing reputation and ranking. Ranking could simply wait until there's no 
-     * lock but applying reputation we would have to store changes in a secondary table rep_delta, apply all changes there while rep ranking is happening
-     * and apply the delta back to the full table once rep ranking is finished.
+     * Ranking chains lock the table they walk (see tables/rank_lock_table.hpp): while the lock is held
+     * changes to the ranked value are buffered in a pending table and merged once ranking has finished,
+     * so current is always < total and every account is counted exactly once.
      * 
-     * 
-     * The count rebalances the next time we go over it, it's a dynamic system. 
-
-     * The cheap way to fix it is to limit rank to 99
+     * The cap only matters for chains that don't take a lock (regions).
     */
     uint64_t r = (current * 100) / total; 
     if (r > 99) return 99;
@@ -229,6 +219,59 @@ namespace utils {
     return date.utc_seconds;
   }
 
+  bool is_rank_locked(const name & code, const name & scope) {
+
+    DEFINE_RANK_LOCK_TABLE
+    DEFINE_RANK_LOCK_TABLE_MULTI_INDEX
+
+    rank_lock_tables ranklocks(code, code.value);
+
+    auto litr = ranklocks.find(scope.value);
+    if (litr == ranklocks.end()) {
+      return false;
+    }
+
+    return litr->timestamp + rank_lock_timeout > eosio::current_time_point().sec_since_epoch();
+
+  }
+
+  // takes or refreshes the lock
+  void rank_lock(const name & code, const name & scope) {
+
+    DEFINE_RANK_LOCK_TABLE
+    DEFINE_RANK_LOCK_TABLE_MULTI_INDEX
+
+    rank_lock_tables ranklocks(code, code.value);
+    uint64_t now = eosio::current_time_point().sec_since_epoch();
+
+    auto litr = ranklocks.find(scope.value);
+    if (litr == ranklocks.end()) {
+      ranklocks.emplace(code, [&](auto & item){
+        item.scope = scope;
+        item.timestamp = now;
+      });
+    } else {
+      ranklocks.modify(litr, code, [&](auto & item){
+        item.timestamp = now;
+      });
+    }
+
+  }
+
+  void rank_unlock(const name & code, const name & scope) {
+
+    DEFINE_RANK_LOCK_TABLE
+    DEFINE_RANK_LOCK_TABLE_MULTI_INDEX
+
+    rank_lock_tables ranklocks(code, code.value);
+
+    auto litr = ranklocks.find(scope.value);
+    if (litr != ranklocks.end()) {
+      ranklocks.erase(litr);
+    }
+
+  }
+
   template <typename T>
   inline void delete_table (const name & code, const uint64_t & scope) {
 
@@ -0,0 +1,80 @@
+#!/usr/bin/env node
+
+// Benchmark for Document::hashContents (document_graph)
+//
+// Runs quests::testhashdoc on a local node for documents of 10 to 500 contents and reports
+// the action's elapsed time (microseconds) from the transaction trace. Every hash is checked
+// against the canonical string built here in JS, so a change to the serializer that alters
+// the output - and with it every existing document hash - shows up as a mismatch.
+//
+// Example:
+//   ./scripts/benchmark.document.js run
+//   ./scripts/benchmark.document.js run --sizes 10,100,500 --runs 5
+
+const crypto = require('crypto')
+const program = require('commander')
+const { eos, names, isLocal } = require('./helper')
+const { quests } = names
+
+const sha256 = (str) => crypto.createHash('sha256').update(str).digest('hex')
+
+// same contents as quests::testhashdoc
+const content = (i) => {
+  const label = `c${i}`
+  switch (i % 6) {
+    case 0: return `{${label}=[int64,${i * 1000}]}`
+    case 1: return `{${label}=[asset,${(i / 10000).toFixed(4)} SEEDS]}`
+    case 2: return `{${label}=[time_point,${1600000000 + i}]}`
+    case 3: return `{${label}=[string,value ${i}]}`
+    case 4: return `{${label}=[checksum256,${sha256(label)}]}`
+    default: return `{${label}=[name,seeds]}`
+  }
+}
+
+const expectedHash = (numContents) => {
+  const groups = []
+  for (let i = 0; i < numContents; i++) {
+    if (i % 10 == 0) groups.push([])
+    groups[groups.length - 1].push(content(i))
+  }
+  return sha256('[' + groups.map(g => '[' + g.join(',') + ']').join(',') + ']')
+}
+
+program
+  .command('run')
+  .description('Hash synthetic documents and report elapsed time per size')
+  .option('-s, --sizes <sizes>', 'comma separated content counts', (v) => v.split(',').map(n => parseInt(n)), [10, 50, 100, 250, 500])
+  .option('-r, --runs <runs>', 'runs per size', (v) => parseInt(v), 3)
+  .action(async ({ sizes, runs }) => {
+    if (!isLocal()) {
+      console.log("only run benchmarks on local")
+      return
+    }
+
+    const contract = await eos.contract(quests)
+
+    console.log('contents\tmin us\tavg us\thash')
+
+    for (const size of sizes) {
+      const elapsed = []
+      let hash
+
+      for (let run = 0; run < runs; run++) {
+        const res = await contract.testhashdoc(size, { authorization: `${quests}@active` })
+        const trace = res.processed.action_traces[0]
+        elapsed.push(trace.elapsed)
+        hash = trace.console
+      }
+
+      const expected = expectedHash(size)
+      const avg = Math.round(elapsed.reduce((a, b) => a + b, 0) / elapsed.length)
+      console.log(`${size}\t\t${Math.min(...elapsed)}\t${avg}\t${hash == expected ? 'ok' : `MISMATCH expected ${expected} got ${hash}`}`)
+    }
+  })
+
+program.parse(process.argv)
+
+var NO_COMMAND_SPECIFIED = program.args.length === 0;
+if (NO_COMMAND_SPECIFIED) {
+  program.help();
+}
@@ -0,0 +1,138 @@
+#!/usr/bin/env node
+
+// Benchmark for the harvest ranking chains (rankplanted, ranktx, calccs, rankcs)
+//
+// Runs on a local node only - resets harvest and accounts, seeds synthetic users
+// with harvest::testseed and accounts::testseedrep, then runs every chain with the
+// given chunk size and reads back each chunk's action trace from the history plugin.
+//
+// Per chunk it reports wall time (action trace elapsed, in microseconds), rows processed
+// and the table reads / writes / secondary index operations the chunk counted and printed
+// to its console (see include/benchmark.hpp).
+//
+// testseed, testseedrep and the counters are only compiled in with BENCHMARK=1, deploy a
+// benchmark build of harvest and accounts to the local node first.
+//
+// Example:
+//   ./scripts/benchmark.harvest.js run --users 50000 --chunksize 200
+//   ./scripts/benchmark.harvest.js run --users 50000 --chunksize 400 --chains rankplanted,ranktx
+
+const program = require('commander')
+const { eos, names, isLocal, sleep } = require('./helper')
+const { harvest, accounts } = names
+
+const chains = {
+  rankplanted: (chunksize) => [0, 0, chunksize],
+  ranktx: (chunksize) => [0, 0, chunksize, harvest],
+  calccs: (chunksize) => [0, 0, chunksize],
+  rankcs: (chunksize) => [0, 0, chunksize, harvest],
+}
+
+const seedBatch = 200
+
+const readCounters = (trace) => {
+  const match = /bench reads=(\d+) writes=(\d+) secondary=(\d+)/.exec(trace || '')
+  return match ? match.slice(1).map(n => parseInt(n)) : null
+}
+
+const seed = async (contracts, users) => {
+  console.log(`seeding ${users} users`)
+  for (let start = 0; start < users; start += seedBatch) {
+    const count = Math.min(seedBatch, users - start)
+    await contracts.accounts.testseedrep(start, count, { authorization: `${accounts}@active` })
+    await contracts.harvest.testseed(start, count, { authorization: `${harvest}@active` })
+  }
+}
+
+const lastActionSeq = async () => {
+  const { actions } = await eos.getActions(harvest, -1, -1)
+  return actions.length > 0 ? actions[actions.length - 1].account_action_seq : -1
+}
+
+const collectChunks = async (chain, fromSeq, expectedChunks) => {
+  let chunks = []
+  let idle = 0
+
+  // each chunk schedules the next one with a 1 second delay
+  while (chunks.length < expectedChunks && idle < 10) {
+    await sleep(1000)
+    const { actions } = await eos.getActions(harvest, fromSeq + 1, 1000)
+    const found = actions
+      .map(({ action_trace }) => action_trace)
+      .filter(trace => trace.receiver == harvest && trace.act.name == chain)
+    idle = found.length == chunks.length ? idle + 1 : 0
+    chunks = found
+  }
+
+  return chunks
+}
+
+const runChain = async (contracts, chain, users, chunksize) => {
+  const args = chains[chain]
+  const expectedChunks = Math.ceil(users / chunksize)
+
+  const fromSeq = await lastActionSeq()
+  await contracts.harvest[chain](...args(chunksize), { authorization: `${harvest}@active` })
+
+  const chunks = await collectChunks(chain, fromSeq, expectedChunks)
+
+  console.log(`\n${chain} - ${users} users, chunksize ${chunksize}, ${chunks.length}/${expectedChunks} chunks`)
+  console.log('chunk\trows\telapsed us\treads\twrites\tsec idx ops')
+
+  let totalElapsed = 0
+  let totalOps = [0, 0, 0]
+  chunks.forEach(({ act, elapsed, console: trace }) => {
+    const rows = Math.min(chunksize, users - act.data.chunk * chunksize)
+    const ops = readCounters(trace)
+    if (ops) {
+      totalOps = totalOps.map((total, i) => total + ops[i])
+    }
+    console.log(`${act.data.chunk}\t${rows}\t${elapsed}\t\t${ops ? ops.join('\t') : 'not a benchmark build'}`)
+    totalElapsed += elapsed
+  })
+
+  const maxElapsed = Math.max(...chunks.map(({ elapsed }) => elapsed))
+  console.log(`total\t${users}\t${totalElapsed}\t\t${totalOps.join('\t')}`)
+  console.log(`max chunk elapsed: ${maxElapsed} us, per row: ${(totalElapsed / users).toFixed(2)} us`)
+}
+
+program
+  .command('run')
+  .description('Seed synthetic users and benchmark the harvest ranking chains')
+  .option('-u, --users <users>', 'number of synthetic users', (v) => parseInt(v), 10000)
+  .option('-c, --chunksize <chunksize>', 'rows per chunk', (v) => parseInt(v), 200)
+  .option('--chains <chains>', 'comma separated chains to run', (v) => v.split(','), Object.keys(chains))
+  .option('--noseed', 'reuse data from a previous run')
+  .action(async ({ users, chunksize, chains: selected, noseed }) => {
+    if (!isLocal()) {
+      console.log("only run benchmarks on local - this resets harvest and accounts")
+      return
+    }
+
+    const contracts = {
+      harvest: await eos.contract(harvest),
+      accounts: await eos.contract(accounts),
+    }
+
+    if (!noseed) {
+      console.log('reset harvest and accounts')
+      await contracts.harvest.reset({ authorization: `${harvest}@active` })
+      await contracts.accounts.reset({ authorization: `${accounts}@active` })
+      await seed(contracts, users)
+    }
+
+    for (const chain of selected) {
+      if (!chains[chain]) {
+        console.log(`unknown chain ${chain}, skipping`)
+        continue
+      }
+      await runChain(contracts, chain, users, chunksize)
+    }
+  })
+
+program.parse(process.argv)
+
+var NO_COMMAND_SPECIFIED = program.args.length === 0;
+if (NO_COMMAND_SPECIFIED) {
+  program.help();
+}
@@ -16,11 +16,14 @@ const command = ({ contract, source, include, dir, contractSourceName }) => {
     let inc = include == "" ? "./include" : include
 
     contractSourceName = contractSourceName ?? contract
+
+    // BENCHMARK=1 compiles in the benchmark only actions, never deploy such a build to mainnet
+    const defines = process.env.BENCHMARK ? " -DSEEDS_BENCHMARK" : ""
     
     if (process.env.COMPILER === 'local') {
-      cmd = "eosio-cpp -abigen -I "+ inc +" -contract " + contractSourceName + " -o ./artifacts/"+contract+".wasm "+source;
+      cmd = "eosio-cpp -abigen" + defines + " -I "+ inc +" -contract " + contractSourceName + " -o ./artifacts/"+contract+".wasm "+source;
     } else {
-      cmd = `docker run --rm --name eosio.cdt_v1.7.0-rc1 --volume ${volume}:/project -w /project eostudio/eosio.cdt:v1.7.0-rc1 /bin/bash -c "echo 'starting';eosio-cpp -abigen -I ${inc} -contract ${contract} -o ./artifacts/${contract}.wasm ${source}"`
+      cmd = `docker run --rm --name eosio.cdt_v1.7.0-rc1 --volume ${volume}:/project -w /project eostudio/eosio.cdt:v1.7.0-rc1 /bin/bash -c "echo 'starting';eosio-cpp -abigen${defines} -I ${inc} -contract ${contract} -o ./artifacts/${contract}.wasm ${source}"`
     }
     console.log("compiler command: " + cmd);
     return cmd
@@ -606,6 +606,9 @@ var permissions = [{
 }, {
   target: `${accounts.onboarding.account}@application`,
   action: 'acceptexist'
+}, {
+  target: `${accounts.onboarding.account}@application`,
+  action: 'acceptbatch'
 }, {
   target: `${accounts.harvest.account}@payforcpu`,
   key: payForCPUPublicKey,
@@ -676,6 +679,9 @@ var permissions = [{
 }, {
   target: `${accounts.harvest.account}@execute`,
   action: 'rankrgncss'
+}, {
+  target: `${accounts.harvest.account}@execute`,
+  action: 'rankalls'
 }, {
   target: `${accounts.gratitude.account}@active`,
   actor: `${accounts.gratitude.account}@eosio.code`
@@ -779,6 +785,12 @@ var permissions = [{
 }, {
   target: `${accounts.history.account}@execute`,
   action: 'cleanptrxs'
+}, {
+  target: `${accounts.history.account}@execute`,
+  action: 'savetrxs'
+}, {
+  target: `${accounts.history.account}@execute`,
+  action: 'expiretrxs'
 }, {
   target: `${accounts.dao.account}@active`,
   actor: `${accounts.dao.account}@eosio.code`
@@ -788,6 +800,9 @@ var permissions = [{
 }, {
   target: `${accounts.accounts.account}@addrep`,
   action: 'addrep'
+}, {
+  target: `${accounts.accounts.account}@addrep`,
+  action: 'addreps'
 }, {
   target: `${accounts.settings.account}@referendum`,
   actor: `${accounts.dao.account}@eosio.code`,
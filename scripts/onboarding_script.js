@@ -502,7 +502,7 @@ const escrowBalance = async (account) => {
     const escrow = await eos.getTableRows({
       code: "escrow.seeds",
       scope: "escrow.seeds",
-      table: 'locks',
+      table: 'tokenlocks',
       lower_bound: next,
       json: true,
       limit: 1000
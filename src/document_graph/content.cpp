@@ -18,37 +18,75 @@ namespace hypha
 
     const std::string Content::toString() const
     {
-        if (isEmpty()) return "";
-        
-        std::string str = "{" + std::string(label) + "=";
+        std::string str;
+        appendTo(str);
+        return str;
+    }
+
+    // writes the canonical form used for document hashes, do not change the format
+    void Content::appendTo(std::string &out) const
+    {
+        if (isEmpty()) return;
+
+        out += '{';
+        out += label;
+        out += '=';
         if (std::holds_alternative<std::int64_t>(value))
         {
-            str += "[int64," + std::to_string(std::get<std::int64_t>(value)) + "]";
+            out += "[int64,";
+            out += std::to_string(std::get<std::int64_t>(value));
         }
         else if (std::holds_alternative<eosio::asset>(value))
         {
-            str += "[asset," + std::get<eosio::asset>(value).to_string() + "]";
+            out += "[asset,";
+            out += std::get<eosio::asset>(value).to_string();
         }
         else if (std::holds_alternative<eosio::time_point>(value))
         {
-            str += "[time_point," + std::to_string(std::get<eosio::time_point>(value).sec_since_epoch()) + "]";
+            out += "[time_point,";
+            out += std::to_string(std::get<eosio::time_point>(value).sec_since_epoch());
         }
         else if (std::holds_alternative<std::string>(value))
         {
-            str += "[string," + std::get<std::string>(value) + "]";
+            out += "[string,";
+            out += std::get<std::string>(value);
         }
         else if (std::holds_alternative<eosio::checksum256>(value))
         {
-            eosio::checksum256 cs_value = std::get<eosio::checksum256>(value);
-            auto arr = cs_value.extract_as_byte_array();
-            std::string str_value = toHex((const char *)arr.data(), arr.size());
-            str += "[checksum256," + str_value + "]";
+            out += "[checksum256,";
+            out += readableHash(std::get<eosio::checksum256>(value));
         }
         else
         {
-            str += "[name," + std::get<eosio::name>(value).to_string() + "]";
+            out += "[name,";
+            out += std::get<eosio::name>(value).to_string();
         }
-        str += "}";
-        return str;
+        out += "]}";
+    }
+
+    // upper bound of what appendTo writes, used to size the buffer once
+    const size_t Content::serializedSizeHint() const
+    {
+        // '{', '=', "]}" and the longest type prefix "[checksum256,"
+        size_t size = label.size() + 17;
+        if (std::holds_alternative<std::string>(value))
+        {
+            size += std::get<std::string>(value).size();
+        }
+        else if (std::holds_alternative<eosio::checksum256>(value))
+        {
+            size += 64;
+        }
+        else if (std::holds_alternative<eosio::asset>(value))
+        {
+            // sign, 19 digits and the decimal point, a space and a 7 character symbol
+            size += 29;
+        }
+        else
+        {
+            // an int64 with its sign, longer than a name or time_point seconds
+            size += 20;
+        }
+        return size;
     }
 } // namespace hypha
\ No newline at end of file
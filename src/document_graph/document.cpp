@@ -154,9 +154,23 @@ namespace hypha
         return eosio::sha256(const_cast<char *>(string_data.c_str()), string_data.length());
     }
 
+    // the whole document is written into one buffer sized up front, no intermediate strings
     const std::string Document::toString(const ContentGroups &contentGroups)
     {
-        std::string results = "[";
+        size_t size = 2;
+        for (const ContentGroup &contentGroup : contentGroups)
+        {
+            size += 3;
+            for (const Content &content : contentGroup)
+            {
+                size += content.serializedSizeHint() + 1;
+            }
+        }
+
+        std::string results;
+        results.reserve(size);
+
+        results += '[';
         bool is_first = true;
 
         for (const ContentGroup &contentGroup : contentGroups)
@@ -167,18 +181,25 @@ namespace hypha
             }
             else
             {
-                results = results + ",";
+                results += ',';
             }
-            results = results + toString(contentGroup);
+            appendTo(results, contentGroup);
         }
 
-        results = results + "]";
+        results += ']';
         return results;
     }
 
     const std::string Document::toString(const ContentGroup &contentGroup)
     {
-        std::string results = "[";
+        std::string results;
+        appendTo(results, contentGroup);
+        return results;
+    }
+
+    void Document::appendTo(std::string &out, const ContentGroup &contentGroup)
+    {
+        out += '[';
         bool is_first = true;
 
         for (const Content &content : contentGroup)
@@ -189,13 +210,12 @@ namespace hypha
             }
             else
             {
-                results = results + ",";
+                out += ',';
             }
-            results = results + content.toString();
+            content.appendTo(out);
         }
 
-        results = results + "]";
-        return results;
+        out += ']';
     }
 
     ContentGroups Document::rollup(ContentGroup contentGroup)
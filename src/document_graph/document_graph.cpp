@@ -1,26 +1,32 @@
 #include <document_graph/document_graph.hpp>
 #include <document_graph/document.hpp>
+#include <document_graph/edge_cache.hpp>
 #include <document_graph/util.hpp>
 
 namespace hypha
 {
     std::vector<Edge> DocumentGraph::getEdges(const eosio::checksum256 &fromNode, const eosio::checksum256 &toNode)
     {
+        EdgeCache::Key key = EdgeCache::fromTo(m_contract, fromNode, toNode);
+        if (const std::vector<Edge> *cached = EdgeCache::find(key))
+        {
+            return *cached;
+        }
+
         std::vector<Edge> edges;
 
         // this index uniquely identifies all edges that share this fromNode and toNode
-        uint64_t index = concatHash(fromNode, toNode);
-        Edge::edge_table e_t(m_contract, m_contract.value);
+        Edge::edge_table e_t = Edge::table(m_contract);
         auto from_name_index = e_t.get_index<eosio::name("byfromto")>();
-        auto itr = from_name_index.find(index);
+        auto itr = from_name_index.find(hashKey(fromNode, toNode));
 
-        while (itr != from_name_index.end() && itr->by_from_node_to_node_index() == index)
+        while (itr != from_name_index.end() && itr->from_node == fromNode && itr->to_node == toNode)
         {
             edges.push_back(*itr);
             itr++;
         }
 
-        return edges;
+        return EdgeCache::store(key, std::move(edges));
     }
 
     std::vector<Edge> DocumentGraph::getEdgesOrFail(const eosio::checksum256 &fromNode, const eosio::checksum256 &toNode)
@@ -32,21 +38,26 @@ namespace hypha
 
     std::vector<Edge> DocumentGraph::getEdgesFrom(const eosio::checksum256 &fromNode, const eosio::name &edgeName)
     {
+        EdgeCache::Key key = EdgeCache::fromName(m_contract, fromNode, edgeName);
+        if (const std::vector<Edge> *cached = EdgeCache::find(key))
+        {
+            return *cached;
+        }
+
         std::vector<Edge> edges;
 
         // this index uniquely identifies all edges that share this fromNode and edgeName
-        uint64_t index = concatHash(fromNode, edgeName);
-        Edge::edge_table e_t(m_contract, m_contract.value);
+        Edge::edge_table e_t = Edge::table(m_contract);
         auto from_name_index = e_t.get_index<eosio::name("byfromname")>();
-        auto itr = from_name_index.find(index);
+        auto itr = from_name_index.find(hashKey(fromNode, edgeName));
 
-        while (itr != from_name_index.end() && itr->by_from_node_edge_name_index() == index)
+        while (itr != from_name_index.end() && itr->from_node == fromNode && itr->edge_name == edgeName)
         {
             edges.push_back(*itr);
             itr++;
         }
 
-        return edges;
+        return EdgeCache::store(key, std::move(edges));
     }
 
     std::vector<Edge> DocumentGraph::getEdgesFromOrFail(const eosio::checksum256 &fromNode, const eosio::name &edgeName)
@@ -58,21 +69,26 @@ namespace hypha
 
     std::vector<Edge> DocumentGraph::getEdgesTo(const eosio::checksum256 &toNode, const eosio::name &edgeName)
     {
+        EdgeCache::Key key = EdgeCache::toName(m_contract, toNode, edgeName);
+        if (const std::vector<Edge> *cached = EdgeCache::find(key))
+        {
+            return *cached;
+        }
+
         std::vector<Edge> edges;
 
         // this index uniquely identifies all edges that share this toNode and edgeName
-        uint64_t index = concatHash(toNode, edgeName);
-        Edge::edge_table e_t(m_contract, m_contract.value);
+        Edge::edge_table e_t = Edge::table(m_contract);
         auto from_name_index = e_t.get_index<eosio::name("bytoname")>();
-        auto itr = from_name_index.find(index);
+        auto itr = from_name_index.find(hashKey(toNode, edgeName));
 
-        while (itr != from_name_index.end() && itr->by_to_node_edge_name_index() == index)
+        while (itr != from_name_index.end() && itr->to_node == toNode && itr->edge_name == edgeName)
         {
             edges.push_back(*itr);
             itr++;
         }
 
-        return edges;
+        return EdgeCache::store(key, std::move(edges));
     }
 
     std::vector<Edge> DocumentGraph::getEdgesToOrFail(const eosio::checksum256 &toNode, const eosio::name &edgeName)
@@ -86,13 +102,14 @@ namespace hypha
     // would instantiate the table on each call.  This is faster execution.
     void DocumentGraph::removeEdges(const eosio::checksum256 &node)
     {
-        Edge::edge_table e_t(m_contract, m_contract.value);
+        Edge::edge_table e_t = Edge::table(m_contract);
 
         auto from_node_index = e_t.get_index<eosio::name("fromnode")>();
         auto from_itr = from_node_index.find(node);
 
-        while (from_itr != from_node_index.end() && from_itr->to_node == node)
+        while (from_itr != from_node_index.end() && from_itr->from_node == node)
         {
+            EdgeCache::invalidate(m_contract, from_itr->from_node, from_itr->to_node, from_itr->edge_name);
             from_itr = from_node_index.erase(from_itr);
         }
 
@@ -101,14 +118,64 @@ namespace hypha
 
         while (to_itr != to_node_index.end() && to_itr->to_node == node)
         {
+            EdgeCache::invalidate(m_contract, to_itr->from_node, to_itr->to_node, to_itr->edge_name);
             to_itr = to_node_index.erase(to_itr);
         }
     }
 
-    void DocumentGraph::replaceNode(const eosio::checksum256 &oldNode, const eosio::checksum256 &newNode)
+    // moves up to limit edges from the old edges table to the new one, keeping creator and created date
+    // returns true once the old table is empty
+    bool DocumentGraph::migrateEdges(uint64_t limit)
     {
+        LegacyEdge::edge_table legacy_t(m_contract, m_contract.value);
         Edge::edge_table e_t(m_contract, m_contract.value);
 
+        auto litr = legacy_t.begin();
+        uint64_t count = 0;
+
+        while (litr != legacy_t.end() && count < limit)
+        {
+            auto fromToIndex = e_t.get_index<eosio::name("byfromto")>();
+            auto fitr = fromToIndex.find(hashKey(litr->from_node, litr->to_node));
+            bool exists = false;
+
+            while (fitr != fromToIndex.end() && fitr->from_node == litr->from_node && fitr->to_node == litr->to_node)
+            {
+                if (fitr->edge_name == litr->edge_name)
+                {
+                    exists = true;
+                    break;
+                }
+                fitr++;
+            }
+
+            if (!exists)
+            {
+                uint64_t id = Edge::newId(e_t, litr->from_node, litr->to_node, litr->edge_name);
+                e_t.emplace(m_contract, [&](auto &e) {
+                    e.id = id;
+                    e.from_node = litr->from_node;
+                    e.to_node = litr->to_node;
+                    e.edge_name = litr->edge_name;
+                    e.created_date = litr->created_date;
+                    e.creator = litr->creator;
+                    e.contract = litr->contract;
+                });
+
+                EdgeCache::invalidate(m_contract, litr->from_node, litr->to_node, litr->edge_name);
+            }
+
+            litr = legacy_t.erase(litr);
+            count++;
+        }
+
+        return litr == legacy_t.end();
+    }
+
+    void DocumentGraph::replaceNode(const eosio::checksum256 &oldNode, const eosio::checksum256 &newNode)
+    {
+        Edge::edge_table e_t = Edge::table(m_contract);
+
         auto from_node_index = e_t.get_index<eosio::name("fromnode")>();
         auto from_itr = from_node_index.find(oldNode);
 
@@ -118,6 +185,7 @@ namespace hypha
             Edge newEdge(m_contract, m_contract, newNode, from_itr->to_node, from_itr->edge_name);
 
             // erase the old edge record
+            EdgeCache::invalidate(m_contract, from_itr->from_node, from_itr->to_node, from_itr->edge_name);
             from_itr = from_node_index.erase(from_itr);
         }
 
@@ -130,6 +198,7 @@ namespace hypha
             Edge newEdge(m_contract, m_contract, to_itr->from_node, newNode, to_itr->edge_name);
 
             // erase the old edge record
+            EdgeCache::invalidate(m_contract, to_itr->from_node, to_itr->to_node, to_itr->edge_name);
             to_itr = to_node_index.erase(to_itr);
         }
     }
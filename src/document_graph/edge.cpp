@@ -1,9 +1,34 @@
 #include <document_graph/document.hpp>
 #include <document_graph/edge.hpp>
+#include <document_graph/edge_cache.hpp>
 #include <document_graph/util.hpp>
 
 namespace hypha
 {
+    namespace
+    {
+        // there are only a few edges between two nodes, walk them and compare the edge name
+        template <typename Index>
+        auto findEdge(Index &index,
+                      const eosio::checksum256 &_from_node,
+                      const eosio::checksum256 &_to_node,
+                      const eosio::name &_edge_name)
+        {
+            auto itr = index.find(hashKey(_from_node, _to_node));
+
+            while (itr != index.end() && itr->from_node == _from_node && itr->to_node == _to_node)
+            {
+                if (itr->edge_name == _edge_name)
+                {
+                    return itr;
+                }
+                itr++;
+            }
+
+            return index.end();
+        }
+    } // namespace
+
     Edge::Edge() {}
     Edge::Edge(const eosio::name &contract,
                const eosio::name &creator,
@@ -24,12 +49,11 @@ namespace hypha
                      const eosio::checksum256 &_to_node,
                      const eosio::name &_edge_name)
     {
-        edge_table e_t(_contract, _contract.value);
+        edge_table e_t = table(_contract);
+        uint64_t id = newId(e_t, _from_node, _to_node, _edge_name);
+
         e_t.emplace(_contract, [&](auto &e) {
-            e.id = concatHash(_from_node, _to_node, _edge_name);
-            e.from_node_edge_name_index = concatHash(_from_node, _edge_name);
-            e.from_node_to_node_index = concatHash(_from_node, _to_node);
-            e.to_node_edge_name_index = concatHash(_to_node, _edge_name);
+            e.id = id;
             e.creator = _creator;
             e.contract = _contract;
             e.from_node = _from_node;
@@ -37,6 +61,40 @@ namespace hypha
             e.edge_name = _edge_name;
             e.created_date = eosio::current_time_point();
         });
+
+        EdgeCache::invalidate(_contract, _from_node, _to_node, _edge_name);
+    }
+
+    // static
+    Edge::edge_table Edge::table(const eosio::name &contract)
+    {
+        // edges only move to the new table, so once it is seen empty the legacy table stays empty for this action
+        static bool migrated = false;
+
+        if (!migrated)
+        {
+            LegacyEdge::edge_table legacy_t(contract, contract.value);
+            eosio::check(legacy_t.begin() == legacy_t.end(), "edges migration pending, run migrateedges first");
+            migrated = true;
+        }
+
+        return edge_table(contract, contract.value);
+    }
+
+    // static
+    uint64_t Edge::newId(edge_table &e_t,
+                         const eosio::checksum256 &_from_node,
+                         const eosio::checksum256 &_to_node,
+                         const eosio::name &_edge_name)
+    {
+        uint64_t id = foldHash(hashKey(_from_node, _to_node, _edge_name));
+
+        while (e_t.find(id) != e_t.end())
+        {
+            id++;
+        }
+
+        return id;
     }
 
     // static
@@ -46,10 +104,11 @@ namespace hypha
                         const eosio::checksum256 &_to_node,
                         const eosio::name &_edge_name)
     {
-        edge_table e_t(_contract, _contract.value);
-        auto itr = e_t.find(concatHash(_from_node, _to_node, _edge_name));
+        edge_table e_t = table(_contract);
+        auto fromToIndex = e_t.get_index<eosio::name("byfromto")>();
+        auto itr = findEdge(fromToIndex, _from_node, _to_node, _edge_name);
 
-        if (itr != e_t.end())
+        if (itr != fromToIndex.end())
         {
             return *itr;
         }
@@ -63,10 +122,11 @@ namespace hypha
                    const eosio::checksum256 &_to_node,
                    const eosio::name &_edge_name)
     {
-        edge_table e_t(_contract, _contract.value);
-        auto itr = e_t.find(concatHash(_from_node, _to_node, _edge_name));
+        edge_table e_t = table(_contract);
+        auto fromToIndex = e_t.get_index<eosio::name("byfromto")>();
+        auto itr = findEdge(fromToIndex, _from_node, _to_node, _edge_name);
 
-        eosio::check(itr != e_t.end(), "edge does not exist: from " + readableHash(_from_node) + " to " + readableHash(_to_node) + " with edge name of " + _edge_name.to_string());
+        eosio::check(itr != fromToIndex.end(), "edge does not exist: from " + readableHash(_from_node) + " to " + readableHash(_to_node) + " with edge name of " + _edge_name.to_string());
 
         return *itr;
     }
@@ -76,12 +136,11 @@ namespace hypha
                    const eosio::checksum256 &_from_node,
                    const eosio::name &_edge_name)
     {
-        edge_table e_t(_contract, _contract.value);
+        edge_table e_t = table(_contract);
         auto fromEdgeIndex = e_t.get_index<eosio::name("byfromname")>();
-        auto index = concatHash(_from_node, _edge_name);
-        auto itr = fromEdgeIndex.find(index);
+        auto itr = fromEdgeIndex.find(hashKey(_from_node, _edge_name));
 
-        eosio::check(itr != fromEdgeIndex.end() && itr->from_node_edge_name_index == index, "edge does not exist: from " + readableHash(_from_node) + " with edge name of " + _edge_name.to_string());
+        eosio::check(itr != fromEdgeIndex.end() && itr->from_node == _from_node && itr->edge_name == _edge_name, "edge does not exist: from " + readableHash(_from_node) + " with edge name of " + _edge_name.to_string());
 
         return *itr;
     }
@@ -91,11 +150,14 @@ namespace hypha
                       const eosio::checksum256 &_from_node,
                       const eosio::name &_edge_name)
     {
-        edge_table e_t(_contract, _contract.value);
+        edge_table e_t = table(_contract);
         auto fromEdgeIndex = e_t.get_index<eosio::name("byfromname")>();
-        auto index = concatHash(_from_node, _edge_name);
         std::vector<Edge> edges;
-        for (auto itr = fromEdgeIndex.find(index); itr != fromEdgeIndex.end(); ++itr) {
+
+        for (auto itr = fromEdgeIndex.find(hashKey(_from_node, _edge_name));
+             itr != fromEdgeIndex.end() && itr->from_node == _from_node && itr->edge_name == _edge_name;
+             ++itr)
+        {
             edges.push_back(*itr);
         }
 
@@ -107,12 +169,11 @@ namespace hypha
                                             const eosio::checksum256 &_from_node,
                                             const eosio::name &_edge_name)
     {
-        edge_table e_t(_contract, _contract.value);
+        edge_table e_t = table(_contract);
         auto fromEdgeIndex = e_t.get_index<eosio::name("byfromname")>();
-        auto index = concatHash(_from_node, _edge_name);
-        auto itr = fromEdgeIndex.find(index);
+        auto itr = fromEdgeIndex.find(hashKey(_from_node, _edge_name));
 
-        if (itr != fromEdgeIndex.end() && itr->from_node_edge_name_index == index)
+        if (itr != fromEdgeIndex.end() && itr->from_node == _from_node && itr->edge_name == _edge_name)
         {
             return std::pair<bool, Edge> (true, *itr);
         }
@@ -126,45 +187,46 @@ namespace hypha
                       const eosio::checksum256 &_to_node,
                       const eosio::name &_edge_name)
     {
-        edge_table e_t(_contract, _contract.value);
-        auto itr = e_t.find(concatHash(_from_node, _to_node, _edge_name));
-        if (itr != e_t.end())
-            return true;
-        return false;
+        edge_table e_t = table(_contract);
+        auto fromToIndex = e_t.get_index<eosio::name("byfromto")>();
+        return findEdge(fromToIndex, _from_node, _to_node, _edge_name) != fromToIndex.end();
     }
 
     void Edge::emplace()
     {
-        // update indexes prior to save
-        id = concatHash(from_node, to_node, edge_name);
-        from_node_edge_name_index = concatHash(from_node, edge_name);
-        from_node_to_node_index = concatHash(from_node, to_node);
-        to_node_edge_name_index = concatHash(to_node, edge_name);
+        edge_table e_t = table(getContract());
+
+        // update id prior to save
+        id = newId(e_t, from_node, to_node, edge_name);
 
-        edge_table e_t(getContract(), getContract().value);
         e_t.emplace(getContract(), [&](auto &e) {
             e = *this;
             e.created_date = eosio::current_time_point();
         });
+
+        EdgeCache::invalidate(*this);
     }
 
     void Edge::erase()
     {
-        edge_table e_t(getContract(), getContract().value);
+        edge_table e_t = table(getContract());
         auto itr = e_t.find(id);
 
-        eosio::check(itr != e_t.end(), "edge does not exist: from " + readableHash(from_node) + " to " + readableHash(to_node) + " with edge name of " + edge_name.to_string());
+        eosio::check(itr != e_t.end() && itr->from_node == from_node && itr->to_node == to_node && itr->edge_name == edge_name,
+                     "edge does not exist: from " + readableHash(from_node) + " to " + readableHash(to_node) + " with edge name of " + edge_name.to_string());
         e_t.erase(itr);
+
+        EdgeCache::invalidate(*this);
     }
 
     uint64_t Edge::primary_key() const { return id; }
-    uint64_t Edge::by_from_node_edge_name_index() const { return from_node_edge_name_index; }
-    uint64_t Edge::by_from_node_to_node_index() const { return from_node_to_node_index; }
-    uint64_t Edge::by_to_node_edge_name_index() const { return to_node_edge_name_index; }
+    eosio::checksum256 Edge::by_from_node_edge_name_index() const { return hashKey(from_node, edge_name); }
+    eosio::checksum256 Edge::by_from_node_to_node_index() const { return hashKey(from_node, to_node); }
+    eosio::checksum256 Edge::by_to_node_edge_name_index() const { return hashKey(to_node, edge_name); }
     uint64_t Edge::by_edge_name() const { return edge_name.value; }
     uint64_t Edge::by_created() const { return created_date.sec_since_epoch(); }
     uint64_t Edge::by_creator() const { return creator.value; }
 
     eosio::checksum256 Edge::by_from() const { return from_node; }
     eosio::checksum256 Edge::by_to() const { return to_node; }
-} // namespace hypha
\ No newline at end of file
+} // namespace hypha
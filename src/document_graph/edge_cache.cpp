@@ -0,0 +1,64 @@
+#include <document_graph/edge_cache.hpp>
+
+namespace hypha
+{
+
+    std::map<EdgeCache::Key, std::vector<Edge>> &EdgeCache::lists()
+    {
+        static std::map<Key, std::vector<Edge>> cached;
+        return cached;
+    }
+
+    EdgeCache::Key EdgeCache::fromTo(const eosio::name &contract, const eosio::checksum256 &fromNode, const eosio::checksum256 &toNode)
+    {
+        return Key{contract, FROM_TO, fromNode, toNode, eosio::name()};
+    }
+
+    EdgeCache::Key EdgeCache::fromName(const eosio::name &contract, const eosio::checksum256 &fromNode, const eosio::name &edgeName)
+    {
+        return Key{contract, FROM_NAME, fromNode, eosio::checksum256(), edgeName};
+    }
+
+    EdgeCache::Key EdgeCache::toName(const eosio::name &contract, const eosio::checksum256 &toNode, const eosio::name &edgeName)
+    {
+        return Key{contract, TO_NAME, toNode, eosio::checksum256(), edgeName};
+    }
+
+    const std::vector<Edge> *EdgeCache::find(const Key &key)
+    {
+        auto itr = lists().find(key);
+        return itr == lists().end() ? nullptr : &itr->second;
+    }
+
+    const std::vector<Edge> &EdgeCache::store(const Key &key, std::vector<Edge> edges)
+    {
+        return lists()[key] = std::move(edges);
+    }
+
+    void EdgeCache::invalidate(const eosio::name &contract,
+                               const eosio::checksum256 &fromNode,
+                               const eosio::checksum256 &toNode,
+                               const eosio::name &edgeName)
+    {
+        auto &cached = lists();
+        if (cached.empty())
+        {
+            return;
+        }
+
+        cached.erase(fromTo(contract, fromNode, toNode));
+        cached.erase(fromName(contract, fromNode, edgeName));
+        cached.erase(toName(contract, toNode, edgeName));
+    }
+
+    void EdgeCache::invalidate(const Edge &edge)
+    {
+        invalidate(edge.contract, edge.from_node, edge.to_node, edge.edge_name);
+    }
+
+    void EdgeCache::clear()
+    {
+        lists().clear();
+    }
+
+} // namespace hypha
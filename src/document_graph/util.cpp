@@ -1,3 +1,6 @@
+#include <array>
+#include <cstring>
+
 #include <eosio/crypto.hpp>
 #include <eosio/name.hpp>
 
@@ -22,32 +25,56 @@ namespace hypha
         return toHex((const char *)byte_arr.data(), byte_arr.size());
     }
 
-    const std::uint64_t toUint64(const std::string &fingerprint)
+    const eosio::checksum256 hashKey(const eosio::checksum256 &sha1, const eosio::checksum256 &sha2, const eosio::name &label)
     {
-        uint64_t id = 0;
-        eosio::checksum256 h = eosio::sha256(const_cast<char *>(fingerprint.c_str()), fingerprint.size());
-        auto hbytes = h.extract_as_byte_array();
-        for (int i = 0; i < 4; i++)
-        {
-            id <<= 8;
-            id |= hbytes[i];
-        }
-        return id;
+        std::array<uint8_t, 72> buffer;
+        auto bytes1 = sha1.extract_as_byte_array();
+        auto bytes2 = sha2.extract_as_byte_array();
+        uint64_t value = label.value;
+
+        std::memcpy(buffer.data(), bytes1.data(), 32);
+        std::memcpy(buffer.data() + 32, bytes2.data(), 32);
+        std::memcpy(buffer.data() + 64, &value, 8);
+
+        return eosio::sha256(reinterpret_cast<const char *>(buffer.data()), buffer.size());
     }
 
-    const uint64_t concatHash(const eosio::checksum256 sha1, const eosio::checksum256 sha2, const eosio::name label)
+    const eosio::checksum256 hashKey(const eosio::checksum256 &sha1, const eosio::checksum256 &sha2)
     {
-        return toUint64(readableHash(sha1) + readableHash(sha2) + label.to_string());
+        std::array<uint8_t, 64> buffer;
+        auto bytes1 = sha1.extract_as_byte_array();
+        auto bytes2 = sha2.extract_as_byte_array();
+
+        std::memcpy(buffer.data(), bytes1.data(), 32);
+        std::memcpy(buffer.data() + 32, bytes2.data(), 32);
+
+        return eosio::sha256(reinterpret_cast<const char *>(buffer.data()), buffer.size());
     }
 
-    const uint64_t concatHash(const eosio::checksum256 sha1, const eosio::checksum256 sha2)
+    const eosio::checksum256 hashKey(const eosio::checksum256 &sha, const eosio::name &label)
     {
-        return toUint64(readableHash(sha1) + readableHash(sha2));
+        std::array<uint8_t, 40> buffer;
+        auto bytes = sha.extract_as_byte_array();
+        uint64_t value = label.value;
+
+        std::memcpy(buffer.data(), bytes.data(), 32);
+        std::memcpy(buffer.data() + 32, &value, 8);
+
+        return eosio::sha256(reinterpret_cast<const char *>(buffer.data()), buffer.size());
     }
 
-    const uint64_t concatHash(const eosio::checksum256 sha, const eosio::name label)
+    // xor of the four 64 bit words, so every byte of the hash counts
+    const std::uint64_t foldHash(const eosio::checksum256 &hash)
     {
-        return toUint64(readableHash(sha) + label.to_string());
+        auto bytes = hash.extract_as_byte_array();
+        uint64_t id = 0;
+        for (int i = 0; i < 32; i += 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, bytes.data() + i, 8);
+            id ^= word;
+        }
+        return id;
     }
 
 } // namespace hypha
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include <document_graph/variable_document.hpp>
+#include <document_graph/util.hpp>
+
+namespace hypha
+{
+
+    VariableDocument::VariableDocument() {}
+
+    VariableDocument::VariableDocument(eosio::name contract, eosio::name creator, ContentGroups contentGroups)
+        : Document(contract, creator, std::move(contentGroups))
+    {
+    }
+
+    VariableDocument::VariableDocument(eosio::name contract, const eosio::checksum256 &_hash)
+    {
+        document_table d_t(contract, contract.value);
+        auto hash_index = d_t.get_index<eosio::name("idhash")>();
+        auto h_itr = hash_index.find(_hash);
+        eosio::check(h_itr != hash_index.end(), "document not found: " + readableHash(_hash));
+
+        Document::operator=(*h_itr);
+    }
+
+    void VariableDocument::modify()
+    {
+        document_table d_t(getContract(), getContract().value);
+        auto d_itr = d_t.find(primary_key());
+        eosio::check(d_itr != d_t.end(), "document not found: " + readableHash(getHash()));
+
+        d_t.modify(d_itr, getContract(), [&](auto &d) {
+            d = *this;
+        });
+    }
+
+} // namespace hypha
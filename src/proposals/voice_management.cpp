@@ -149,54 +149,19 @@ ACTION dao::decayvoices () {
       && (now - c.t_onperiod >= decay_time)
       && (now - c.t_voicedecay >= decay_sec)
   ) {
-    c.t_voicedecay = now;
-    cycle_t.set(c, get_self());
-    uint64_t batch_size = config_get(name("batchsize"));
-    decayvoice(0, batch_size);
-  }
-}
-
-ACTION dao::decayvoice (const uint64_t & start, const uint64_t & chunksize) {
-  require_auth(get_self());
-
-  voice_tables voices(get_self(), campaign_scope.value);
-
-  print("decaying voices!\n", "chunksize:", chunksize, "\n");
-
-  uint64_t percentage_decay = config_get(name("vdecayprntge"));
-  check(percentage_decay <= 100, "Voice decay parameter can not be more than 100%.");
-  
-  auto vitr = voices.lower_bound(start);
-  uint64_t count = 0;
-
-  double multiplier = (100.0 - (double)percentage_decay) / 100.0;
-
-  while (vitr != voices.end() && count < chunksize) {
-
-    print("account:", vitr->account, "\n");
-
-    for (auto & s : scopes) {
-      voice_tables voice_t(get_self(), s.value);
-      auto voice_itr = voice_t.find(vitr->account.value);
+    uint64_t percentage_decay = config_get(name("vdecayprntge"));
+    check(percentage_decay <= 100, "Voice decay parameter can not be more than 100%.");
 
-      if (voice_itr != voice_t.end()) {
-        voice_t.modify(voice_itr, _self, [&](auto & v){
-          v.balance *= multiplier;
-        });
-      }
+    // voice rows are only brought up to date when they are next read or written (voice_balance)
+    if (percentage_decay == 100) {
+      c.decay_epoch = c.decay_epoch.value_or(0) + 1;
+      c.decay_index = 0.0;
+    } else {
+      c.decay_index = c.decay_index.value_or(0) - std::log((100.0 - (double)percentage_decay) / 100.0);
     }
 
-    vitr++;
-    count += 2;
-  }
-
-  if (vitr != voices.end()) {
-    send_deferred_transaction(
-      permission_level(get_self(), "active"_n),
-      get_self(),
-      "decayvoice"_n,
-      std::make_tuple(vitr->account.value, chunksize)
-    );
+    c.t_voicedecay = now;
+    cycle_t.set(c, get_self());
   }
 }
 
@@ -314,7 +279,7 @@ ACTION dao::mimicvote (
         permission_level(get_self(), "active"_n),
         get_self(),
         "voteonbehalf"_n,
-        std::make_tuple(voter, proposal_id, uint64_t(vitr->balance * percentage_used), option)
+        std::make_tuple(voter, proposal_id, uint64_t(voice_balance(*vitr) * percentage_used), option)
       );
     }
 
@@ -422,6 +387,26 @@ ACTION dao::testsetvoice (const name & account, const uint64_t & amount) {
 }
 
 
+uint64_t dao::voice_balance (const voice_table & v) {
+  cycle_tables cycle_t(get_self(), get_self().value);
+  cycle_table c = cycle_t.get_or_default(cycle_table());
+
+  if (v.decay_epoch.value_or(0) != c.decay_epoch.value_or(0)) {
+    return 0;
+  }
+
+  double decayed = v.balance * std::exp(v.decay_index.value_or(0) - c.decay_index.value_or(0));
+  return uint64_t(decayed + 0.000001);
+}
+
+void dao::stamp_voice (voice_table & v) {
+  cycle_tables cycle_t(get_self(), get_self().value);
+  cycle_table c = cycle_t.get_or_default(cycle_table());
+
+  v.decay_index = c.decay_index.value_or(0);
+  v.decay_epoch = c.decay_epoch.value_or(0);
+}
+
 void dao::set_voice (const name & user, const uint64_t & amount, const name & scope) {
   if (scope == "all"_n) {
 
@@ -435,12 +420,14 @@ void dao::set_voice (const name & user, const uint64_t & amount, const name & sc
         voice_t.emplace(_self, [&](auto & voice){
           voice.account = user;
           voice.balance = amount;
+          stamp_voice(voice);
         });
       }
       else {
         increase_size = false;
         voice_t.modify(vitr, _self, [&](auto & voice){
           voice.balance = amount;
+          stamp_voice(voice);
         });
       }
     }
@@ -457,10 +444,12 @@ void dao::set_voice (const name & user, const uint64_t & amount, const name & sc
       voice_t.emplace(_self, [&](auto & voice){
         voice.account = user;
         voice.balance = amount;
+        stamp_voice(voice);
       });
     } else {
       voice_t.modify(vitr, _self, [&](auto & voice){
         voice.balance = amount;
+        stamp_voice(voice);
       });
     }
   }
@@ -476,15 +465,17 @@ double dao::voice_change (const name & user, const uint64_t & amount, const bool
       auto vitr = voice_t.find(user.value);
 
       if (vitr != voice_t.end()) {
+        uint64_t balance = voice_balance(*vitr);
         if (reduce) {
-          check(amount <= vitr->balance, s.to_string() + " voice balance exceeded");
+          check(amount <= balance, s.to_string() + " voice balance exceeded");
         }
         voice_t.modify(vitr, _self, [&](auto & voice){
           if (reduce) {
-            voice.balance -= amount;
+            voice.balance = balance - amount;
           } else {
-            voice.balance += amount;
+            voice.balance = balance + amount;
           }
+          stamp_voice(voice);
         });
       }
     }
@@ -492,17 +483,19 @@ double dao::voice_change (const name & user, const uint64_t & amount, const bool
   } else {    
     voice_tables voice_t(get_self(), scope.value);
     auto vitr = voice_t.require_find(user.value, "user does not have voice");
+    uint64_t balance = voice_balance(*vitr);
 
     if (reduce) {
-      check(amount <= vitr->balance, "voice balance exceeded");
-      percentage_used = amount / double(vitr -> balance);
+      check(amount <= balance, "voice balance exceeded");
+      percentage_used = amount / double(balance);
     }
     voice_t.modify(vitr, _self, [&](auto & voice){
       if (reduce) {
-        voice.balance -= amount;
+        voice.balance = balance - amount;
       } else {
-        voice.balance += amount;
+        voice.balance = balance + amount;
       }
+      stamp_voice(voice);
     });
   }
 
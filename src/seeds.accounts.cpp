@@ -32,10 +32,25 @@ void accounts::reset() {
   utils::delete_table<rep_tables>(contracts::accounts, contracts::accounts.value);
   utils::delete_table<rep_tables>(contracts::accounts, organization_scope.value);
 
+  utils::delete_table<rep_pending_tables>(contracts::accounts, contracts::accounts.value);
+  utils::delete_table<rep_pending_tables>(contracts::accounts, organization_scope.value);
+
+  utils::delete_table<rep_count_tables>(contracts::accounts, contracts::accounts.value);
+  utils::delete_table<rep_count_tables>(contracts::accounts, organization_scope.value);
+
+  utils::delete_table<rep_dirty_tables>(contracts::accounts, contracts::accounts.value);
+  utils::delete_table<rep_dirty_tables>(contracts::accounts, organization_scope.value);
+
+  utils::delete_table<rank_lock_tables>(contracts::accounts, contracts::accounts.value);
+
   utils::delete_table<size_tables>(contracts::accounts, contracts::accounts.value);
 
   utils::delete_table<ban_tables>(contracts::accounts, contracts::accounts.value);
 
+  utils::delete_table<ban_queue_tables>(contracts::accounts, contracts::accounts.value);
+
+  utils::delete_table<flag_queue_tables>(contracts::accounts, contracts::accounts.value);
+
   utils::delete_table<delegators_tables>(contracts::accounts, contracts::accounts.value);
   
   utils::delete_table<flags_tables>(contracts::accounts, contracts::accounts.value);
@@ -142,10 +157,13 @@ void accounts::_vouch(name sponsor, name account) {
         item.account = account;
         item.vouch_points = vouch_points;
       });
+
+      calc_vouch_rep(account, int64_t(vouch_points));
+      return;
     }
   }
 
-  calc_vouch_rep(account); 
+  calc_vouch_rep(account, 0); 
 }
 
 void accounts::pnishvouched (name sponsor, uint64_t start_account) {
@@ -154,26 +172,40 @@ void accounts::pnishvouched (name sponsor, uint64_t start_account) {
   uint64_t batch_size = config_get("batchsize"_n);
   uint128_t id = (uint128_t(sponsor.value) << 64) + start_account;
 
-  auto vouches_by_account = vouches.get_index<"byaccount"_n>();
   auto vouches_by_sponsor_account = vouches.get_index<"byspnsoracct"_n>();
   uint64_t count = 0;
   uint64_t max_vouch = config_get(max_vouch_points);
 
   auto vitr = vouches_by_sponsor_account.lower_bound(id);
 
+  // rep changes for the batch, sent once per account
+  std::map<name, int64_t> rep_deltas;
+
   while (vitr != vouches_by_sponsor_account.end() && vitr->sponsor == sponsor && count < batch_size) {
 
-    vouches_by_sponsor_account.modify(vitr, _self, [&](auto & item){
-      item.vouch_points = 0;
-    });
+    int64_t vouch_points = int64_t(vitr->vouch_points);
 
-    calc_vouch_rep(vitr->account);
+    if (vouch_points > 0) {
+      vouches_by_sponsor_account.modify(vitr, _self, [&](auto & item){
+        item.vouch_points = 0;
+      });
+
+      rep_deltas[vitr->account] += change_vouch_points(vitr->account, -vouch_points, max_vouch);
+    }
 
     vitr++;
     count++;
 
   }
 
+  for (const auto & [account, rep_delta] : rep_deltas) {
+    if (rep_delta > 0) {
+      send_addrep(account, uint64_t(rep_delta));
+    } else if (rep_delta < 0) {
+      send_subrep(account, uint64_t(-rep_delta));
+    }
+  }
+
   if (vitr != vouches_by_sponsor_account.end() && vitr->sponsor == sponsor) {
     action next_execution(
       permission_level{get_self(), "active"_n},
@@ -189,51 +221,50 @@ void accounts::pnishvouched (name sponsor, uint64_t start_account) {
   }
 }
 
-void accounts::calc_vouch_rep (name account) {
-  auto vouches_by_account = vouches.get_index<"byaccount"_n>();
-  auto vitr = vouches_by_account.find(account.value);
+void accounts::calc_vouch_rep (name account, int64_t vouch_delta) {
+  int64_t rep_delta = change_vouch_points(account, vouch_delta, config_get(max_vouch_points));
 
-  uint64_t max_vouch = config_get(max_vouch_points);
+  if (rep_delta > 0) {
+    send_addrep(account, uint64_t(rep_delta));
+  } else if (rep_delta < 0) {
+    send_subrep(account, uint64_t(-rep_delta));
+  }
+}
+
+// Applies a change in the account's vouch points to its vouch totals, returns the change in vouch rep
+int64_t accounts::change_vouch_points (name account, int64_t vouch_delta, uint64_t max_vouch) {
   uint64_t total_vouch = 0;
   uint64_t total_rep = 0;
 
-  while (vitr != vouches_by_account.end() && vitr->account == account) {
-    total_vouch += vitr -> vouch_points;
-    vitr++;
+  auto vtitr = vouchtotals.find(account.value);
+  if (vtitr != vouchtotals.end()) {
+    total_vouch = vtitr->total_vouch_points;
+    total_rep = vtitr->total_rep_points;
   }
 
-  auto vtitr = vouchtotals.find(account.value);
-  if (vtitr != vouchtotals.end()) { total_rep = vtitr->total_rep_points; }
+  if (vouch_delta < 0 && uint64_t(-vouch_delta) > total_vouch) {
+    total_vouch = 0;
+  } else {
+    total_vouch += vouch_delta;
+  }
 
   uint64_t total_vouch_capped = std::min(total_vouch, max_vouch);
-  uint64_t delta = 0;
-
-  if (total_rep < total_vouch_capped) {
-    
-    delta = total_vouch_capped - total_rep;
-    send_addrep(account, delta);
-    total_rep += delta;
-
-  } else if (total_rep > total_vouch_capped) {
-
-    delta = total_rep - total_vouch_capped;
-    send_subrep(account, delta);
-    total_rep -= delta;
-
-  }
+  int64_t rep_delta = int64_t(total_vouch_capped) - int64_t(total_rep);
 
   if (vtitr == vouchtotals.end()) {
     vouchtotals.emplace(_self, [&](auto & item){
       item.account = account;
       item.total_vouch_points = total_vouch;
-      item.total_rep_points = total_rep;
+      item.total_rep_points = total_vouch_capped;
     });
   } else {
     vouchtotals.modify(vtitr, _self, [&](auto & item){
       item.total_vouch_points = total_vouch;
-      item.total_rep_points = total_rep;
+      item.total_rep_points = total_vouch_capped;
     });
   }
+
+  return rep_delta;
 }
 
 
@@ -461,31 +492,52 @@ void accounts::invitevouch(name referrer, name invited)
   _vouch(referrer, invited);
 }
 
-void accounts::addrep(name user, uint64_t amount)
+void accounts::onboardusers(std::vector<std::tuple<name, name, string>> invites)
 {
   require_auth(get_self());
 
-  check(is_account(user), "non existing user");
-  check(amount > 0, "amount must be > 0");
-
-  auto uitr = users.find(user.value);
+  uint64_t now = eosio::current_time_point().sec_since_epoch();
+  int added = 0;
 
-  users.modify(uitr, _self, [&](auto& user) {
-    user.reputation += amount;
-  });
+  for (const auto & [referrer, account, nickname] : invites) {
+    check(is_account(referrer), "wrong referral");
+    check(is_account(account), "no account");
+    check(nickname.size() <= 64, "nickname must be less than 65 characters long");
 
-  name scope = get_scope(uitr->type);
+    if (users.find(account.value) != users.end()) continue;
 
-  rep_tables rep_t(get_self(), scope.value);
+    users.emplace(_self, [&](auto& user) {
+        user.account = account;
+        user.status = visitor;
+        user.reputation = 0;
+        user.type = individual;
+        user.nickname = nickname;
+        user.timestamp = now;
+    });
 
-  auto ritr = rep_t.find(user.value);
-  if (ritr == rep_t.end()) {
-    add_rep_item(user, amount, scope);
-  } else {
-    rep_t.modify(ritr, _self, [&](auto& item) {
-      item.rep += amount;
+    refs.emplace(_self, [&](auto& ref) {
+      ref.referrer = referrer;
+      ref.invited = account;
     });
+
+    _vouch(referrer, account);
+
+    added++;
+  }
+
+  if (added > 0) {
+    size_change("users.sz"_n, added);
   }
+}
+
+void accounts::addrep(name user, uint64_t amount)
+{
+  require_auth(get_self());
+
+  check(is_account(user), "non existing user");
+  check(amount > 0, "amount must be > 0");
+
+  change_user_rep(user, int64_t(amount));
 
 }
 
@@ -496,37 +548,119 @@ void accounts::subrep(name user, uint64_t amount)
   check(is_account(user), "non existing user");
   check(amount > 0, "amount must be > 0");
 
-  // modify user reputation - deprecated
-  auto uitr = users.find(user.value);
+  change_user_rep(user, -int64_t(amount));
 
-  users.modify(uitr, _self, [&](auto& user) {
-    if (user.reputation < amount) {
-      user.reputation = 0;
+}
+
+void accounts::addreps(std::vector<std::pair<name, int64_t>> reps)
+{
+  require_auth(get_self());
+
+  for (const auto & [user, amount] : reps) {
+    if (amount == 0 || users.find(user.value) == users.end()) continue;
+    change_user_rep(user, amount);
+  }
+
+}
+
+void accounts::change_user_rep(name user, int64_t delta)
+{
+  auto uitr = users.require_find(user.value, "user not found");
+
+  // modify user reputation - deprecated
+  users.modify(uitr, _self, [&](auto& item) {
+    if (delta < 0 && item.reputation < uint64_t(-delta)) {
+      item.reputation = 0;
     } else {
-      user.reputation -= amount;
+      item.reputation += delta;
     }
   });
 
-  name scope = get_scope(uitr->type);
+  change_rep(user, get_scope(uitr->type), delta);
+}
+
+// While rankrep walks a scope the change is buffered so every account is ranked exactly once
+void accounts::change_rep(name account, name scope, int64_t delta)
+{
+  if (!utils::is_rank_locked(get_self(), scope)) {
+    apply_rep_change(account, scope, delta);
+    return;
+  }
+
+  rep_pending_tables reppending(get_self(), scope.value);
+
+  auto pitr = reppending.find(account.value);
+  if (pitr == reppending.end()) {
+    reppending.emplace(_self, [&](auto& item) {
+      item.account = account;
+      item.delta = delta;
+    });
+  } else {
+    reppending.modify(pitr, _self, [&](auto& item) {
+      item.delta += delta;
+    });
+  }
+}
+
+void accounts::apply_rep_change(name account, name scope, int64_t delta)
+{
+  if (delta == 0) return;
 
   rep_tables rep_t(get_self(), scope.value);
 
-  auto ritr = rep_t.find(user.value);
-  if (ritr != rep_t.end()) {
-    if (ritr->rep > amount) {
-      rep_t.modify(ritr, _self, [&](auto& item) {
-        item.rep -= amount;
-      });
-    } else {
-      rep_t.erase(ritr);
-      if (scope == individual_scope) {
-        size_change("rep.sz"_n, -1);
-      } else if (scope == organization_scope) {
-        size_change("rep.org.sz"_n, -1);
-      }
+  auto ritr = rep_t.find(account.value);
+  if (ritr == rep_t.end()) {
+    if (delta > 0) {
+      add_rep_item(account, delta, scope);
+      mark_rep_dirty(account, scope);
+    }
+  } else if (int64_t(ritr->rep) + delta > 0) {
+    rep_count_change(scope, ritr->rep, -1);
+    rep_count_change(scope, ritr->rep + delta, 1);
+    rep_t.modify(ritr, _self, [&](auto& item) {
+      item.rep += delta;
+    });
+    mark_rep_dirty(account, scope);
+  } else {
+    rep_count_change(scope, ritr->rep, -1);
+    rep_t.erase(ritr);
+    if (scope == individual_scope) {
+      size_change("rep.sz"_n, -1);
+    } else if (scope == organization_scope) {
+      size_change("rep.org.sz"_n, -1);
     }
+    // nothing left to rerank, but everyone above moved down a position
+    size_change(scope == individual_scope ? "rep.chg.sz"_n : "rep.ochg.sz"_n, 1);
+  }
+}
+
+void accounts::mergereps(name scope, uint64_t chunksize)
+{
+  require_auth(get_self());
+
+  // a new ranking started - its own merge picks up the remaining changes
+  if (utils::is_rank_locked(get_self(), scope)) return;
+
+  rep_pending_tables reppending(get_self(), scope.value);
+
+  auto pitr = reppending.begin();
+  uint64_t count = 0;
+
+  while (pitr != reppending.end() && count < chunksize) {
+    apply_rep_change(pitr->account, scope, pitr->delta);
+    pitr = reppending.erase(pitr);
+    count++;
   }
 
+  if (pitr != reppending.end()) {
+    utils::send_deferred_transaction(
+      get_self(),
+      permission_level(get_self(), "active"_n),
+      get_self(),
+      "mergereps"_n,
+      std::make_tuple(scope, chunksize)
+    );
+  }
 }
 
 name accounts::get_scope (name type) {
@@ -788,12 +922,110 @@ uint32_t accounts::num_transactions(name account, uint32_t limit) {
   return titr -> total_number_of_transactions;
 }
 
+void accounts::mark_rep_dirty(name account, name scope)
+{
+  rep_dirty_tables repdirty(get_self(), scope.value);
+
+  if (repdirty.find(account.value) == repdirty.end()) {
+    repdirty.emplace(_self, [&](auto& item) {
+      item.account = account;
+    });
+    size_change(scope == individual_scope ? "rep.chg.sz"_n : "rep.ochg.sz"_n, 1);
+  }
+}
+
 void accounts::rankreps() {
-  rankrep(0, 0, 200, individual_scope);
+  start_rank_rep(individual_scope);
 }
 
 void accounts::rankorgreps() {
-  rankrep(0, 0, 200, organization_scope);
+  start_rank_rep(organization_scope);
+}
+
+// While fewer than 0.1% of the scope changed or left since the last full ranking only the changed
+// accounts are reranked, the others keep a stale rank. Each change moves an unchanged account's position
+// and the total by at most one, so its percentile drifts by less than a fifth of a spline_rank step and
+// crosses at most one step boundary. Neighbouring steps are at most 1.47 ranks apart, so a stale rank is
+// off by at most two until the next full rankrep
+void accounts::start_rank_rep(name scope) {
+  uint64_t total = get_size(scope == individual_scope ? "rep.sz"_n : "rep.org.sz"_n);
+  uint64_t changes = get_size(scope == individual_scope ? "rep.chg.sz"_n : "rep.ochg.sz"_n);
+
+  if (!utils::is_rank_locked(get_self(), scope) && changes * 1000 < total) {
+    rerankrep(scope, 200);
+  } else {
+    rankrep(0, 0, 200, scope);
+  }
+}
+
+void accounts::rerankrep(name scope, uint64_t chunksize) {
+  require_auth(_self);
+
+  // a full ranking started, it ranks the dirty accounts as well
+  if (utils::is_rank_locked(get_self(), scope)) return;
+
+  uint64_t total = get_size(scope == individual_scope ? "rep.sz"_n : "rep.org.sz"_n);
+
+  rep_tables rep_t(get_self(), scope.value);
+  rep_count_tables repcounts(get_self(), scope.value);
+  rep_dirty_tables repdirty(get_self(), scope.value);
+
+  // accounts below each rep value
+  std::map<uint64_t, uint64_t> below;
+  uint64_t counted = 0;
+  for (auto citr = repcounts.begin(); citr != repcounts.end(); citr++) {
+    below[citr->rep] = counted;
+    counted += citr->count;
+  }
+
+  if (counted != total) {
+    rankrep(0, 0, chunksize, scope);
+    return;
+  }
+
+  auto rep_by_rep = rep_t.get_index<"byrep"_n>();
+  auto ditr = repdirty.begin();
+  uint64_t count = 0;
+
+  // chunksize counts the steps over accounts with the same rep too
+  while (ditr != repdirty.end() && count < chunksize) {
+    auto ritr = rep_t.find(ditr->account.value);
+
+    if (ritr != rep_t.end()) {
+      uint64_t position = below[ritr->rep];
+
+      auto bitr = rep_by_rep.lower_bound(uint64_t(ritr->rep) << 32);
+      while (bitr != rep_by_rep.end() && bitr->account != ritr->account) {
+        // too crowded to rerank one by one
+        if (++count > 2 * chunksize) {
+          rankrep(0, 0, chunksize, scope);
+          return;
+        }
+        position++;
+        bitr++;
+      }
+
+      uint64_t rank = utils::spline_rank(position, total);
+      if (ritr->rank != rank) {
+        rep_t.modify(ritr, _self, [&](auto& item) {
+          item.rank = rank;
+        });
+      }
+    }
+
+    ditr = repdirty.erase(ditr);
+    count++;
+  }
+
+  if (ditr != repdirty.end()) {
+    utils::send_deferred_transaction(
+      get_self(),
+      permission_level(get_self(), "active"_n),
+      get_self(),
+      "rerankrep"_n,
+      std::make_tuple(scope, chunksize)
+    );
+  }
 }
 
 void accounts::rankrep(uint64_t start_val, uint64_t chunk, uint64_t chunksize, name scope) {
@@ -807,17 +1039,36 @@ void accounts::rankrep(uint64_t start_val, uint64_t chunk, uint64_t chunksize, n
   }
   if (total == 0) return;
 
+  utils::rank_lock(get_self(), scope);
+
   rep_tables rep_t(get_self(), scope.value);
 
+  // rep changes are buffered while the scope is locked, so the counts are rebuilt along the walk
+  if (start_val == 0) {
+    utils::delete_table<rep_count_tables>(get_self(), scope.value);
+    utils::delete_table<rep_dirty_tables>(get_self(), scope.value);
+    size_set(scope == individual_scope ? "rep.chg.sz"_n : "rep.ochg.sz"_n, 0);
+  }
+
   uint64_t current = chunk * chunksize;
   auto rep_by_rep = rep_t.get_index<"byrep"_n>();
   auto ritr = start_val == 0 ? rep_by_rep.begin() : rep_by_rep.lower_bound(start_val);
   uint64_t count = 0;
 
+  uint64_t run_rep = 0;
+  int64_t run_count = 0;
+
   while (ritr != rep_by_rep.end() && count < chunksize) {
 
     uint64_t rank = utils::spline_rank(current, total);
 
+    if (run_count > 0 && ritr->rep != run_rep) {
+      rep_count_change(scope, run_rep, run_count);
+      run_count = 0;
+    }
+    run_rep = ritr->rep;
+    run_count++;
+
     rep_by_rep.modify(ritr, _self, [&](auto& item) {
       item.rank = rank;
     });
@@ -827,8 +1078,13 @@ void accounts::rankrep(uint64_t start_val, uint64_t chunk, uint64_t chunksize, n
     ritr++;
   }
 
+  if (run_count > 0) {
+    rep_count_change(scope, run_rep, run_count);
+  }
+
   if (ritr == rep_by_rep.end()) {
-    // Done.
+    utils::rank_unlock(get_self(), scope);
+    mergereps(scope, chunksize);
   } else {
     // recursive call
     uint64_t next_value = ritr->by_rep();
@@ -919,6 +1175,8 @@ void accounts::add_rep_item(name account, uint64_t reputation, name scope) {
     item.rep = reputation;
   });
 
+  rep_count_change(scope, reputation, 1);
+
   if (scope == individual_scope) {
     size_change("rep.sz"_n, 1);
   } else if (scope == organization_scope) {
@@ -926,6 +1184,75 @@ void accounts::add_rep_item(name account, uint64_t reputation, name scope) {
   }
 }
 
+void accounts::rep_count_change(name scope, uint64_t rep, int64_t delta) {
+  rep_count_tables repcounts(get_self(), scope.value);
+
+  auto citr = repcounts.find(rep);
+  if (citr == repcounts.end()) {
+    if (delta > 0) {
+      repcounts.emplace(_self, [&](auto& item) {
+        item.rep = rep;
+        item.count = delta;
+      });
+    }
+  } else if (int64_t(citr->count) + delta > 0) {
+    repcounts.modify(citr, _self, [&](auto& item) {
+      item.count += delta;
+    });
+  } else {
+    repcounts.erase(citr);
+  }
+}
+
+// Number of accounts before account in the byrep order. Costs O(rep values) for the prefix sum over
+// the rep counts plus O(accounts with the same rep before it), that second walk gives up after max_steps.
+// Returns false when it gives up or while the counts can't be trusted - a ranking is rebuilding them
+// or they don't add up to the scope size - callers then walk byrep in chunks instead.
+bool accounts::rep_position(name account, name scope, uint64_t total, uint64_t max_steps, uint64_t & position) {
+  if (utils::is_rank_locked(get_self(), scope)) {
+    return false;
+  }
+
+  rep_tables rep_t(get_self(), scope.value);
+  rep_count_tables repcounts(get_self(), scope.value);
+
+  auto ritr = rep_t.find(account.value);
+  if (ritr == rep_t.end()) {
+    return false;
+  }
+
+  uint64_t below = 0;
+  uint64_t counted = 0;
+
+  for (auto citr = repcounts.begin(); citr != repcounts.end(); citr++) {
+    if (citr->rep < ritr->rep) {
+      below += citr->count;
+    }
+    counted += citr->count;
+  }
+
+  if (counted != total) {
+    return false;
+  }
+
+  // accounts with the same rep
+  auto rep_by_rep = rep_t.get_index<"byrep"_n>();
+  auto bitr = rep_by_rep.lower_bound(uint64_t(ritr->rep) << 32);
+
+  uint64_t steps = 0;
+
+  while (bitr != rep_by_rep.end() && bitr->account != account) {
+    if (++steps > max_steps) {
+      return false;
+    }
+    below++;
+    bitr++;
+  }
+
+  position = below;
+  return true;
+}
+
 void accounts::changesize(name id, int64_t delta) {
   require_auth(get_self());
   size_change(id, delta);
@@ -1021,6 +1348,8 @@ void accounts::testsetrep(name user, uint64_t amount) {
   if (ritr == rep_t.end()) {
     add_rep_item(user, amount, scope);
   } else {
+    rep_count_change(scope, ritr->rep, -1);
+    rep_count_change(scope, amount, 1);
     rep_t.modify(ritr, _self, [&](auto& item) {
       item.rep = amount;
     });
@@ -1045,6 +1374,7 @@ void accounts::testsetrs(name user, uint64_t amount) {
       item.account = user;
       item.rank = amount;
     });
+    rep_count_change(scope, 0, 1);
     if (scope == individual_scope) {
       size_change("rep.sz"_n, 1);
     } else if (scope == organization_scope) {
@@ -1057,6 +1387,46 @@ void accounts::testsetrs(name user, uint64_t amount) {
   }
 }
 
+#ifdef SEEDS_BENCHMARK
+// Adds synthetic users with rep for the harvest benchmark - accounts match harvest::testseed
+void accounts::testseedrep(uint64_t start, uint64_t count) {
+  require_auth(get_self());
+
+  name base = "bench"_n;
+  uint64_t new_users = 0;
+  uint64_t new_reps = 0;
+
+  for (uint64_t i = start; i < start + count; i++) {
+    name account = name(base.value + i);
+    uint32_t reputation = (i * 7919) % 1000 + 1;
+
+    if (users.find(account.value) == users.end()) {
+      users.emplace(_self, [&](auto& user) {
+        user.account = account;
+        user.status = visitor;
+        user.reputation = reputation;
+        user.type = individual;
+        user.timestamp = eosio::current_time_point().sec_since_epoch();
+      });
+      new_users++;
+    }
+
+    if (rep.find(account.value) == rep.end()) {
+      rep.emplace(_self, [&](auto& item) {
+        item.account = account;
+        item.rep = reputation;
+        item.rank = reputation % 100;
+      });
+      rep_count_change(individual_scope, reputation, 1);
+      new_reps++;
+    }
+  }
+
+  size_change("users.sz"_n, new_users);
+  size_change("rep.sz"_n, new_reps);
+}
+#endif
+
 void accounts::send_add_cbs_org (name user, uint64_t amount) {
   action(
     permission_level(contracts::organization, "active"_n),
@@ -1129,49 +1499,119 @@ uint64_t accounts::countrefs(name user, int check_num_residents)
 
 }
 
-void accounts::send_bantree(name account) {
-  action send_ban(
-    permission_level(get_self(), "active"_n),
-    get_self(),
-    "bantree"_n,
-    std::make_tuple(account, true)
-  );
+ACTION accounts::bantree(name account, bool recurse) 
+{
+    require_auth(get_self());
 
-  transaction tx;
-  tx.actions.emplace_back(send_ban);
-  tx.delay_sec = 1;
-  tx.send(account.value, _self);
+    ban_account(account);
+
+    if (!recurse) {
+      auto refs_by_referrer = refs.get_index<"byreferrer"_n>();
+      auto ritr = refs_by_referrer.lower_bound(account.value);
+
+      while (ritr != refs_by_referrer.end() && ritr->referrer == account) {
+        print(" invited: "+ritr->invited.to_string());
+        ritr++;
+      }
+      return;
+    }
 
+    if (banqueue.begin() == banqueue.end()) {
+      size_set("bantree.sz"_n, 0);
+    }
+
+    banqueue.emplace(_self, [&](auto & item){
+      item.id = banqueue.available_primary_key();
+      item.account = account;
+      item.next_invited = 0;
+    });
+
+    ban_tree_batch();
 }
 
-ACTION accounts::bantree(name account, bool recurse) 
+ACTION accounts::banbatch() 
 {
     require_auth(get_self());
+    ban_tree_batch();
+}
 
-    ban_tables ban(contracts::accounts, contracts::accounts.value);
-
-    auto bitr = ban.find(account.value);
-    if (bitr == ban.end()) {
-      ban.emplace(_self, [&](auto & item){
-        item.account = account;
-      });
-    } 
+// Bans the invited of the queued accounts breadth first, batchsize referral edges and queue pops per call.
+// Accounts that were already banned are not queued again, so a referral cycle ends.
+// bantree.sz counts the accounts banned since the queue was last empty.
+void accounts::ban_tree_batch() 
+{
+    uint64_t batch_size = config_get("batchsize"_n);
+    uint64_t count = 0;
+    uint64_t banned = 0;
 
     auto refs_by_referrer = refs.get_index<"byreferrer"_n>();
+    auto qitr = banqueue.begin();
+
+    while (qitr != banqueue.end() && count < batch_size) {
+      name referrer = qitr->account;
+
+      auto ritr = qitr->next_invited == 0 ? 
+        refs_by_referrer.lower_bound(referrer.value) : 
+        refs_by_referrer.iterator_to(refs.get(qitr->next_invited, "invited account not found"));
+
+      while (ritr != refs_by_referrer.end() && ritr->referrer == referrer && count < batch_size) {
+        if (ban_account(ritr->invited)) {
+          banqueue.emplace(_self, [&](auto & item){
+            item.id = banqueue.available_primary_key();
+            item.account = ritr->invited;
+            item.next_invited = 0;
+          });
+          banned++;
+        }
 
-    auto ritr = refs_by_referrer.lower_bound(account.value);
-    
-    while (ritr != refs_by_referrer.end() && ritr->referrer == account) {
-      name invited = ritr->invited;
-      if (recurse) {
-        send_bantree(invited);
-      } else {
-        print(" invited: "+invited.to_string());
+        ritr++;
+        count++;
       }
-      ritr++;
+
+      if (ritr != refs_by_referrer.end() && ritr->referrer == referrer) {
+        banqueue.modify(qitr, _self, [&](auto & item){
+          item.next_invited = ritr->invited.value;
+        });
+        break;
+      }
+
+      qitr = banqueue.erase(qitr);
+      count++;
+    }
+
+    size_change("bantree.sz"_n, banned);
+
+    if (banqueue.begin() != banqueue.end()) {
+      action next_execution(
+        permission_level(get_self(), "active"_n),
+        get_self(),
+        "banbatch"_n,
+        std::make_tuple()
+      );
+
+      transaction tx;
+      tx.actions.emplace_back(next_execution);
+      tx.delay_sec = 1;
+      tx.send("banbatch"_n.value, _self, true);
     }
 }
 
+// returns false if the account was banned already
+bool accounts::ban_account(name account) 
+{
+    ban_tables ban(contracts::accounts, contracts::accounts.value);
+
+    auto bitr = ban.find(account.value);
+    if (bitr != ban.end()) {
+      return false;
+    }
+
+    ban.emplace(_self, [&](auto & item){
+      item.account = account;
+    });
+    return true;
+}
+
 ACTION accounts::refinfo(name account) 
 {
     require_auth(get_self());
@@ -1248,12 +1688,24 @@ void accounts::pnshvouchers (name account, uint64_t points, uint64_t start) {
   uint64_t batch_size = config_get("batchsize"_n);
   uint64_t lost_points = points * config_float_get("flag.vouch.p"_n);
 
+  std::vector<std::pair<name, int64_t>> reps;
+
   while (vitr != vouches_by_account_sponsor.end() && vitr->account == account && count < batch_size) {
-    send_subrep(vitr -> sponsor, lost_points);
+    if (lost_points > 0) {
+      reps.push_back(std::make_pair(vitr->sponsor, -int64_t(lost_points)));
+    }
     vitr++;
     count++;
   }
 
+  if (!reps.empty()) {
+    action(
+      permission_level{_self, "active"_n},
+      contracts::accounts, "addreps"_n,
+      std::make_tuple(reps)
+    ).send();
+  }
+
   if (vitr != vouches_by_account_sponsor.end() && vitr->account == account) {
     uint64_t next_value = (vitr -> sponsor).value;
     
@@ -1279,8 +1731,6 @@ void accounts::flag (name from, name to) {
   if (from == to) { return; }
 
   flag_points_tables flag_points(get_self(), to.value);
-  flag_points_tables total_flags(get_self(), flag_total_scope.value);
-  flag_points_tables removed_flags(get_self(), flag_remove_scope.value);
 
   auto fitr = flag_points.find(from.value);
   check(fitr == flag_points.end(), "a user can only flag another user once");
@@ -1289,21 +1739,68 @@ void accounts::flag (name from, name to) {
   auto flags_from_to_itr = flags_by_from_to.find((uint128_t(from.value) << 64) + to.value);
   check(flags_from_to_itr == flags_by_from_to.end(), "can only flag once");
 
-  uint64_t points = 0;
-  uint64_t base_points = 0;
   auto uitr = users.get(from.value, "user not found");
+  check(uitr.status == citizen || uitr.status == resident, "user must be a resident or a citizen");
+
+  rep.get(from.value, (from.to_string() + " needs reputation to flag others").c_str());
+
+  uint64_t points = add_flag(from, to);
+
+  apply_flag_totals(to, int64_t(points));
+
+  queue_mimic_flag(from, to, "flag"_n, 0);
+
+}
+
+void accounts::removeflag (name from, name to) {
+  require_auth(has_auth(from) ? from : get_self());
 
-  if (uitr.status == citizen) {
+  flag_points_tables flag_points(get_self(), to.value);
+  flag_points_tables total_flags(get_self(), flag_total_scope.value);
+
+  auto flags_by_from_to = flags.get_index<"byfromto"_n>();
+
+  check(flag_points.find(from.value) != flag_points.end(), "flag points not found");
+  check(flags_by_from_to.find((uint128_t(from.value) << 64) + to.value) != flags_by_from_to.end(), "flag not found");
+  check(total_flags.find(to.value) != total_flags.end(), to.to_string() + ", has not total flags entry");
+
+  uint64_t points = remove_flag(from, to);
+
+  apply_flag_totals(to, -int64_t(points));
+
+  queue_mimic_flag(from, to, "removeflag"_n, 0);
+}
+
+// Adds the flag from -> to if from is allowed to flag and hasn't flagged to yet, returns its points (0 if not added)
+uint64_t accounts::add_flag (name from, name to) {
+  if (from == to) { return 0; }
+
+  ban_tables ban(contracts::accounts, contracts::accounts.value);
+  if (ban.find(from.value) != ban.end()) { return 0; }
+
+  flag_points_tables flag_points(get_self(), to.value);
+  if (flag_points.find(from.value) != flag_points.end()) { return 0; }
+
+  auto flags_by_from_to = flags.get_index<"byfromto"_n>();
+  if (flags_by_from_to.find((uint128_t(from.value) << 64) + to.value) != flags_by_from_to.end()) { return 0; }
+
+  auto uitr = users.find(from.value);
+  if (uitr == users.end()) { return 0; }
+
+  uint64_t base_points = 0;
+
+  if (uitr->status == citizen) {
     base_points = config_get("flag.base.c"_n);
-  } else if (uitr.status == resident) {
+  } else if (uitr->status == resident) {
     base_points = config_get("flag.base.r"_n);
   } else {
-    check(false, "user must be a resident or a citizen");
+    return 0;
   }
 
-  auto ritr = rep.get(from.value, (from.to_string() + " needs reputation to flag others").c_str());
-  
-  points = base_points * utils::rep_multiplier_for_score(ritr.rank);
+  auto ritr = rep.find(from.value);
+  if (ritr == rep.end()) { return 0; }
+
+  uint64_t points = base_points * utils::rep_multiplier_for_score(ritr->rank);
 
   flag_points.emplace(_self, [&](auto & item){
     item.account = from;
@@ -1317,19 +1814,51 @@ void accounts::flag (name from, name to) {
     item.flag_points = points;
   });
 
+  return points;
+}
+
+// Removes the flag from -> to if there is one, returns its points
+uint64_t accounts::remove_flag (name from, name to) {
+  flag_points_tables flag_points(get_self(), to.value);
+  auto flags_by_from_to = flags.get_index<"byfromto"_n>();
+
+  auto flag_itr = flag_points.find(from.value);
+  if (flag_itr == flag_points.end()) { return 0; }
+
+  uint64_t points = flag_itr->flag_points;
+  flag_points.erase(flag_itr);
+
+  auto flags_from_to_itr = flags_by_from_to.find((uint128_t(from.value) << 64) + to.value);
+  if (flags_from_to_itr != flags_by_from_to.end()) {
+    flags_by_from_to.erase(flags_from_to_itr);
+  }
+
+  return points;
+}
+
+// Changes the account's total flag points and punishes it if the new flags put it over the threshold
+void accounts::apply_flag_totals (name to, int64_t delta) {
+  flag_points_tables total_flags(get_self(), flag_total_scope.value);
+  flag_points_tables removed_flags(get_self(), flag_remove_scope.value);
+
   uint64_t total_flag_points = 0;
   uint64_t removed_flag_points = 0;
 
   auto total_flag_p_itr = total_flags.find(to.value);
   if (total_flag_p_itr != total_flags.end()) { total_flag_points = total_flag_p_itr -> flag_points; }
-  total_flag_points += points;
+
+  if (delta < 0 && uint64_t(-delta) > total_flag_points) {
+    total_flag_points = 0;
+  } else {
+    total_flag_points += delta;
+  }
 
   auto removed_flag_p_itr = removed_flags.find(to.value);
   if (removed_flag_p_itr != removed_flags.end()) { removed_flag_points = removed_flag_p_itr -> flag_points; }
 
   uint64_t flag_threshold = config_get("flag.thresh"_n);
 
-  if (total_flag_points >= flag_threshold && removed_flag_points < total_flag_points) {
+  if (delta > 0 && total_flag_points >= flag_threshold && removed_flag_points < total_flag_points) {
 
     auto to_rep_itr = rep.find(to.value);
     if (to_rep_itr != rep.end()) {
@@ -1363,47 +1892,37 @@ void accounts::flag (name from, name to) {
       item.flag_points = total_flag_points;
     });
   }
-
-  utils::send_deferred_transaction(
-    get_self(),
-    permission_level(get_self(), "active"_n),
-    get_self(),
-    "mimicflag"_n,
-    std::make_tuple(from, to, "flag"_n, config_get(name("batchsize")))
-  );
-
 }
 
-void accounts::removeflag (name from, name to) {
-  require_auth(has_auth(from) ? from : get_self());
+void accounts::queue_mimic_flag (name delegatee, name to, name action, uint64_t depth) {
+  bool queue_was_empty = flagqueue.begin() == flagqueue.end();
 
-  flag_points_tables flag_points(get_self(), to.value);
-  flag_points_tables total_flags(get_self(), flag_total_scope.value);
-  auto flags_by_from_to = flags.get_index<"byfromto"_n>();
-
-  auto flag_itr = flag_points.find(from.value);
-  check(flag_itr != flag_points.end(), "flag points not found");
-
-  auto flags_from_to_itr = flags_by_from_to.find((uint128_t(from.value) << 64) + to.value);
-  check(flags_from_to_itr != flags_by_from_to.end(), "flag not found");
-
-  auto total_flag_p_itr = total_flags.find(to.value);
-  check(total_flag_p_itr != flag_points.end(), to.to_string() + ", has not total flags entry");
-
-  total_flags.modify(total_flag_p_itr, _self, [&](auto & item){
-    item.flag_points -= flag_itr -> flag_points;
+  flagqueue.emplace(_self, [&](auto & item){
+    item.id = flagqueue.available_primary_key();
+    item.delegatee = delegatee;
+    item.to = to;
+    item.action = action;
+    item.depth = depth;
+    item.next_delegator = 0;
   });
 
-  flag_points.erase(flag_itr);
-  flags_by_from_to.erase(flags_from_to_itr);
+  if (queue_was_empty) {
+    send_flag_batch();
+  }
+}
 
-  utils::send_deferred_transaction(
-    get_self(),
+void accounts::send_flag_batch () {
+  action next_execution(
     permission_level(get_self(), "active"_n),
     get_self(),
-    "mimicflag"_n,
-    std::make_tuple(from, to, "removeflag"_n, config_get(name("batchsize")))
+    "flagbatch"_n,
+    std::make_tuple()
   );
+
+  transaction tx;
+  tx.actions.emplace_back(next_execution);
+  tx.delay_sec = 1;
+  tx.send("flagbatch"_n.value, _self, true);
 }
 
 void accounts::check_is_banned(name account)
@@ -1444,6 +1963,14 @@ void accounts::evaldemote (name to, uint64_t start_val, uint64_t chunk, uint64_t
   uint64_t total = get_size("rep.sz"_n);
   if (total == 0) return;
 
+  uint64_t position = 0;
+  if (start_val == 0 && rep_position(to, individual_scope, total, chunksize, position)) {
+    eval_demote_rank(to, utils::spline_rank(position, total));
+    return;
+  }
+
+  // the rep counts are being rebuilt or the account's rep is too crowded - find its position by walking byrep
+
   uint64_t current = chunk * chunksize;
   auto rep_by_rep = rep.get_index<"byrep"_n>();
   auto ritr = start_val == 0 ? rep_by_rep.begin() : rep_by_rep.lower_bound(start_val);
@@ -1453,34 +1980,7 @@ void accounts::evaldemote (name to, uint64_t start_val, uint64_t chunk, uint64_t
   while (ritr != rep_by_rep.end() && count < chunksize) {
 
     if (ritr->account == to) {
-      uint64_t rank = utils::spline_rank(current, total);
-
-      rep_by_rep.modify(ritr, _self, [&](auto& item) {
-        item.rank = rank;
-      });
-
-      auto uitr = users.find(ritr->account.value);
-
-      uint64_t min_rep_score_citizen = config_get("cit.rep.sc"_n);
-      uint64_t min_rep_score_resident = config_get("res.rep.pt"_n);
-
-      name current_rank = uitr->status;
-
-      if (rank < min_rep_score_resident) {
-        current_rank = visitor;
-      } else if (rank < min_rep_score_citizen) {
-        current_rank = resident;
-      } else {
-        current_rank = citizen;
-      }
-
-      if (uitr->status == citizen && current_rank != citizen) {
-        updatestatus(uitr->account, current_rank);
-      }
-      else if (uitr->status == resident && current_rank == visitor) {
-        updatestatus(uitr->account, visitor);
-      }
-
+      eval_demote_rank(to, utils::spline_rank(current, total));
       evaluated = true;
       break;
     }
@@ -1507,6 +2007,38 @@ void accounts::evaldemote (name to, uint64_t start_val, uint64_t chunk, uint64_t
 
 }
 
+void accounts::eval_demote_rank (name account, uint64_t rank) {
+
+  auto ritr = rep.find(account.value);
+
+  rep.modify(ritr, _self, [&](auto& item) {
+    item.rank = rank;
+  });
+
+  auto uitr = users.find(account.value);
+
+  uint64_t min_rep_score_citizen = config_get("cit.rep.sc"_n);
+  uint64_t min_rep_score_resident = config_get("res.rep.pt"_n);
+
+  name current_rank = uitr->status;
+
+  if (rank < min_rep_score_resident) {
+    current_rank = visitor;
+  } else if (rank < min_rep_score_citizen) {
+    current_rank = resident;
+  } else {
+    current_rank = citizen;
+  }
+
+  if (uitr->status == citizen && current_rank != citizen) {
+    updatestatus(uitr->account, current_rank);
+  }
+  else if (uitr->status == resident && current_rank == visitor) {
+    updatestatus(uitr->account, visitor);
+  }
+
+}
+
 
 void accounts::testmvouch (name sponsor, name account, uint64_t reps) {
   require_auth(get_self());
@@ -1577,37 +2109,78 @@ void accounts::undlgateflag (name delegator) {
 
 }
 
+// kept for mimicflag transactions scheduled before flagbatch
 void accounts::mimicflag (name delegatee, name to, name action, uint64_t chunksize) {
+  require_auth(get_self());
+  queue_mimic_flag(delegatee, to, action, 0);
+}
 
+// Copies queued flags and flag removals to the delegators of the queued accounts, breadth first and
+// up to dlegate.dpth levels deep, batchsize delegators per call. A delegator that already flagged
+// (or never flagged) the account is skipped and not followed, so every edge is applied at most once.
+// Total flag points and punishments are updated once per flagged account per batch.
+void accounts::flagbatch () {
   require_auth(get_self());
 
+  uint64_t batch_size = config_get("batchsize"_n);
+  uint64_t max_depth = config_get("dlegate.dpth"_n);
+  uint64_t count = 0;
+
+  std::map<name, int64_t> total_deltas;
+
   delegators_tables delegator_t(get_self(), get_self().value);
   auto delegators_by_delegatee = delegator_t.get_index<"bydelegatee"_n>();
-  auto ditr = delegators_by_delegatee.lower_bound(uint128_t(delegatee.value) << 64);
-  uint64_t count = 0;
 
-  while (ditr != delegators_by_delegatee.end() && ditr->delegatee == delegatee && count < chunksize) {
-    eosio::action(
-      permission_level(get_self(), "active"_n),
-      get_self(),
-      action,
-      std::make_tuple(ditr->delegator, to)
-    ).send();
+  auto qitr = flagqueue.begin();
+
+  while (qitr != flagqueue.end() && count < batch_size) {
+    name delegatee = qitr->delegatee;
+    auto ditr = delegators_by_delegatee.lower_bound((uint128_t(delegatee.value) << 64) + qitr->next_delegator);
+
+    while (ditr != delegators_by_delegatee.end() && ditr->delegatee == delegatee && count < batch_size) {
+      name delegator = ditr->delegator;
+      int64_t delta = qitr->action == "flag"_n ? 
+        int64_t(add_flag(delegator, qitr->to)) : 
+        -int64_t(remove_flag(delegator, qitr->to));
+
+      if (delta != 0) {
+        total_deltas[qitr->to] += delta;
+
+        if (qitr->depth + 1 < max_depth) {
+          flagqueue.emplace(_self, [&](auto & item){
+            item.id = flagqueue.available_primary_key();
+            item.delegatee = delegator;
+            item.to = qitr->to;
+            item.action = qitr->action;
+            item.depth = qitr->depth + 1;
+            item.next_delegator = 0;
+          });
+        }
+      }
 
-    ditr++;
-    count++;
+      ditr++;
+      count++;
+    }
+
+    if (ditr != delegators_by_delegatee.end() && ditr->delegatee == delegatee) {
+      flagqueue.modify(qitr, _self, [&](auto & item){
+        item.next_delegator = ditr->delegator.value;
+      });
+      break;
+    }
+
+    qitr = flagqueue.erase(qitr);
   }
 
-  if (ditr != delegators_by_delegatee.end() && ditr->delegatee == delegatee) {
-    utils::send_deferred_transaction(
-      get_self(),
-      permission_level(get_self(), "active"_n),
-      get_self(),
-      "mimicflag"_n,
-      std::make_tuple(delegatee, to, action, chunksize)
-    );
+  for (const auto & [to, delta] : total_deltas) {
+    if (delta != 0) {
+      apply_flag_totals(to, delta);
+    }
   }
 
+  if (flagqueue.begin() != flagqueue.end()) {
+    send_flag_batch();
+  }
 }
 
 ACTION accounts::migflags1() {
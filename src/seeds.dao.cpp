@@ -359,6 +359,7 @@ ACTION dao::erasepartpts (const uint64_t & active_proposals) {
   uint64_t reward_points = config_get(name("voterep1.ind"));
 
   uint64_t counter = 0;
+  std::vector<std::pair<name, int64_t>> reps;
 
   participant_tables participants_t(get_self(), get_self().value);
   auto pitr = participants_t.begin();
@@ -366,18 +367,22 @@ ACTION dao::erasepartpts (const uint64_t & active_proposals) {
   while (pitr != participants_t.end() && counter < batch_size) {
     if (pitr->count == active_proposals && pitr->nonneutral) {
       if (reward_points > 0) {
-        send_inline_action(
-          permission_level(contracts::accounts, "addrep"_n),
-          contracts::accounts, 
-          "addrep"_n,
-          std::make_tuple(pitr->account, reward_points)
-        );
+        reps.push_back(std::make_pair(pitr->account, int64_t(reward_points)));
       }
     }
     counter += 1;
     pitr = participants_t.erase(pitr);
   }
 
+  if (!reps.empty()) {
+    send_inline_action(
+      permission_level(contracts::accounts, "addrep"_n),
+      contracts::accounts,
+      "addreps"_n,
+      std::make_tuple(reps)
+    );
+  }
+
   if (pitr != participants_t.end()) {
     send_deferred_transaction(
       permission_level(get_self(), "active"_n),
@@ -8,6 +8,12 @@ void escrow::reset() {
         it_e = locks.erase(it_e);
     }
 
+    legacy_token_lock_table legacy_locks(get_self(), get_self().value);
+    auto it_l = legacy_locks.begin();
+    while(it_l != legacy_locks.end()){
+        it_l = legacy_locks.erase(it_l);
+    }
+
     auto it_s = sponsors.begin();
     while(it_s != sponsors.end()) {
         it_s = sponsors.erase(it_s);
@@ -37,6 +43,7 @@ void escrow::trigger (const name&     trigger_source,
 
 void escrow::sendtopool (uint64_t start, uint64_t chunksize) {
     require_auth(get_self());
+    check_locks_migrated();
 
     auto litr = start == 0 ? locks.begin() : locks.lower_bound(start);
     uint64_t current = 0;
@@ -75,50 +82,15 @@ void escrow::sendtopool (uint64_t start, uint64_t chunksize) {
 
 void escrow::miglock (uint64_t lock_id) {
     require_auth(get_self());
+    check_locks_migrated();
 
     auto litr = locks.find(lock_id);
     check(litr != locks.end(), "lock not found");
 
     if (litr->trigger_source == trigger_source_hypha_dao && litr->trigger_event == trigger_event_golive) {
 
-        if (!litr->notes.empty()) {
-            std::size_t found = litr->notes.find(string("proposal id: "));
-            if (found != std::string::npos) {
-                string prop_id_string = litr->notes.substr(13, string::npos);
-                uint64_t prop_id = uint64_t(std::stoi(prop_id_string));
-                action(
-                    permission_level(contracts::proposals, "active"_n),
-                    contracts::proposals,
-                    "checkprop"_n,
-                    std::make_tuple(prop_id, string("proposal is not passing, lock can not be claimed"))
-                ).send();
-                action(
-                    permission_level(contracts::proposals, "active"_n),
-                    contracts::proposals,
-                    "doneprop"_n,
-                    std::make_tuple(prop_id)
-                ).send();
-            }
-
-            // this section is for dao.seeds
-            std::size_t memo = litr->notes.find(string("proposal_id: "));
-            if (memo != std::string::npos) {
-                string prop_id_string = litr->notes.substr(13, string::npos);
-                uint64_t prop_id = uint64_t(std::stoi(prop_id_string));
-
-                std::map<string, VariantValue> args = {
-                    { "proposal_id", prop_id },
-                    { "action", name("doneprop") }
-                };
-
-                action(
-                    permission_level(contracts::dao, "active"_n),
-                    contracts::dao,
-                    "callback"_n,
-                    std::make_tuple(args)
-                ).send();
-            }
-            // =================================
+        if (litr->proposal_contract != name()) {
+            send_proposal_done(litr->proposal_contract, litr->proposal_id);
         }
 
         deduct_from_sponsor(litr->sponsor, litr->quantity);
@@ -127,6 +99,68 @@ void escrow::miglock (uint64_t lock_id) {
     }
 }
 
+void escrow::migratelocks (uint64_t chunksize) {
+    require_auth(get_self());
+
+    legacy_token_lock_table legacy_locks(get_self(), get_self().value);
+    auto litr = legacy_locks.begin();
+    uint64_t count = 0;
+
+    while (litr != legacy_locks.end() && count < chunksize) {
+        std::pair<name, uint64_t> proposal = get_proposal(litr->notes);
+
+        locks.emplace(get_self(), [&](auto & l) {
+            l.id                = litr->id;
+            l.lock_type         = litr->lock_type;
+            l.sponsor           = litr->sponsor;
+            l.beneficiary       = litr->beneficiary;
+            l.quantity          = litr->quantity;
+            l.trigger_event     = litr->trigger_event;
+            l.trigger_source    = litr->trigger_source;
+            l.vesting_date      = litr->vesting_date;
+            l.proposal_contract = proposal.first;
+            l.proposal_id       = proposal.second;
+            l.notes             = litr->notes;
+            l.created_date      = litr->created_date;
+        });
+
+        litr = legacy_locks.erase(litr);
+        count++;
+    }
+
+    if (litr != legacy_locks.end()) {
+        action next_execution(
+            permission_level(get_self(), "active"_n),
+            get_self(),
+            "migratelocks"_n,
+            std::make_tuple(chunksize)
+        );
+
+        transaction tx;
+        tx.actions.emplace_back(next_execution);
+        tx.delay_sec = 1;
+        tx.send("migratelocks"_n.value, _self);
+    }
+}
+
+void escrow::testlgcylock (name sponsor, name beneficiary, asset quantity, string notes) {
+    require_auth(get_self());
+
+    legacy_token_lock_table legacy_locks(get_self(), get_self().value);
+
+    legacy_locks.emplace(get_self(), [&](auto & l) {
+        l.id                = legacy_locks.available_primary_key();
+        l.lock_type         = "time"_n;
+        l.sponsor           = sponsor;
+        l.beneficiary       = beneficiary;
+        l.quantity          = quantity;
+        l.vesting_date      = current_time_point();
+        l.notes             = notes;
+        l.created_date      = current_time_point();
+        l.updated_date      = current_time_point();
+    });
+}
+
 void escrow::lock (   const name&         lock_type, 
                             const name&         sponsor, 
                             const name&         beneficiary,
@@ -149,7 +183,13 @@ void escrow::lock (   const name&         lock_type,
         msponsor.locked_balance += quantity;
     });
 
-    uint64_t lock_id = locks.available_primary_key();
+    // locks that are not migrated yet keep their ids, new ones go after them
+    legacy_token_lock_table legacy_locks(get_self(), get_self().value);
+    uint64_t lock_id = std::max(locks.available_primary_key(), legacy_locks.available_primary_key());
+
+    std::pair<name, uint64_t> proposal = get_proposal(notes);
+    check(proposal.first != name() || (notes.find(string("proposal id: ")) == std::string::npos && notes.find(string("proposal_id: ")) == std::string::npos),
+        "escrow: invalid proposal id in notes " + notes);
 
     locks.emplace (get_self(), [&](auto &l) {
         l.id                = lock_id;
@@ -160,49 +200,43 @@ void escrow::lock (   const name&         lock_type,
         l.trigger_event     = trigger_event;
         l.trigger_source    = trigger_source;
         l.vesting_date      = vesting_date;
+        l.proposal_contract = proposal.first;
+        l.proposal_id       = proposal.second;
         l.notes             = notes;
     });
 
     print("creating lock, memo:", notes, "\n");
 
-    if (!notes.empty()) {
-        std::size_t found = notes.find(string("proposal id: "));
-        if (found != std::string::npos) {
-            string prop_id_string = notes.substr(13, string::npos);
-            uint64_t prop_id = uint64_t(std::stoi(prop_id_string));
-            action(
-                permission_level(contracts::proposals, "active"_n),
-                contracts::proposals,
-                "addcampaign"_n,
-                std::make_tuple(prop_id, lock_id)
-            ).send();
-        }
+    if (proposal.first == contracts::proposals) {
+        action(
+            permission_level(contracts::proposals, "active"_n),
+            contracts::proposals,
+            "addcampaign"_n,
+            std::make_tuple(proposal.second, lock_id)
+        ).send();
+    }
 
-        // this section is for dao.seeds
-        std::size_t memo = notes.find(string("proposal_id: "));
-        if (memo != std::string::npos) {
-            string prop_id_string = notes.substr(13, string::npos);
-            uint64_t prop_id = uint64_t(std::stoi(prop_id_string));
-
-            print("processing lock for prop: ", prop_id, ", lock_id:", lock_id, "\n");
-
-            std::map<string, VariantValue> args = {
-                { "proposal_id", prop_id },
-                { "lock_id", lock_id }
-            };
-
-            action(
-                permission_level(contracts::dao, "active"_n),
-                contracts::dao,
-                "callback"_n,
-                std::make_tuple(args)
-            ).send();
-        }
-        // =============================
+    // this section is for dao.seeds
+    if (proposal.first == contracts::dao) {
+        print("processing lock for prop: ", proposal.second, ", lock_id:", lock_id, "\n");
+
+        std::map<string, VariantValue> args = {
+            { "proposal_id", proposal.second },
+            { "lock_id", lock_id }
+        };
+
+        action(
+            permission_level(contracts::dao, "active"_n),
+            contracts::dao,
+            "callback"_n,
+            std::make_tuple(args)
+        ).send();
     }
+    // =============================
 }
 
 void escrow::cancellock (const uint64_t& lock_id) {
+    check_locks_migrated();
 
     auto l_itr = locks.find (lock_id);
     check (l_itr != locks.end(), "Lock ID " + std::to_string(lock_id) + " does not exist.");
@@ -289,90 +323,58 @@ void escrow::deduct_from_sponsor (name sponsor, asset locked_quantity) {
 
 void escrow::claim(name beneficiary) {
     require_auth(beneficiary);
+    check_locks_migrated();
 
-    auto locks_by_beneficiary = locks.get_index<"bybneficiary"_n>();
-    auto it = locks_by_beneficiary.find(beneficiary.value);
+    // only event locks and vested time locks are visited, see token_lock::by_beneficiary_vesting
+    auto locks_by_beneficiary = locks.get_index<"bybenvesting"_n>();
+    auto it = locks_by_beneficiary.lower_bound(uint128_t(beneficiary.value) << 64);
+    uint128_t last_key = (uint128_t(beneficiary.value) << 64) | current_time_point().sec_since_epoch();
 
     asset zero = asset(0, utils::seeds_symbol);
     asset total_quantity = zero;
     asset pool_quantity = zero;
-    check(it != locks_by_beneficiary.end(), "vstandscrow: The user " + beneficiary.to_string() + " does not have any locks.");
-
-    while(it != locks_by_beneficiary.end()){
-
-        if(it -> beneficiary != beneficiary)
-            break;
-
-        if (!it->notes.empty()) {
-            std::size_t found = it->notes.find(string("proposal id: "));
-            if (found != std::string::npos) {
-                string prop_id_string = it->notes.substr(13, string::npos);
-                uint64_t prop_id = uint64_t(std::stoi(prop_id_string));
-                action(
-                    permission_level(contracts::proposals, "active"_n),
-                    contracts::proposals,
-                    "checkprop"_n,
-                    std::make_tuple(prop_id, string("proposal is not passing, lock can not be claimed"))
-                ).send();
-                action(
-                    permission_level(contracts::proposals, "active"_n),
-                    contracts::proposals,
-                    "doneprop"_n,
-                    std::make_tuple(prop_id)
-                ).send();
-            }
-
-            // this section is for dao.seeds
-            std::size_t memo = it->notes.find(string("proposal_id: "));
-            if (memo != std::string::npos) {
-                string prop_id_string = it->notes.substr(13, string::npos);
-                uint64_t prop_id = uint64_t(std::stoi(prop_id_string));
-
-                std::map<string, VariantValue> args = {
-                    { "proposal_id", prop_id },
-                    { "action", name("doneprop") }
-                };
-
-                action(
-                    permission_level(contracts::dao, "active"_n),
-                    contracts::dao,
-                    "callback"_n,
-                    std::make_tuple(args)
-                ).send();
-            }
-            // =================================
-        }
+    check(it != locks_by_beneficiary.end() && it->beneficiary == beneficiary, "vstandscrow: The user " + beneficiary.to_string() + " does not have any locks.");
+
+    // several locks can pay out the same proposal, it is only told once
+    std::set<std::pair<name, uint64_t>> claimed_proposals;
+
+    while (it != locks_by_beneficiary.end() && it->by_beneficiary_vesting() <= last_key) {
+
+        bool claimable = false;
 
         if (it->lock_type == "time"_n) {
-            if(it -> vesting_date <= current_time_point()){
-                deduct_from_sponsor (it->sponsor, it->quantity);
-                total_quantity += it -> quantity;
-                it = locks_by_beneficiary.erase(it);
-            } else {
-                it++;
-            }
+            claimable = it->vesting_date <= current_time_point();
         } else if (it->lock_type == "event"_n) {
             event_table e_t (get_self(), it->trigger_source.value);
             auto e_itr = e_t.find (it->trigger_event.value);
-            if (e_itr != e_t.end() && e_itr->event_date <= current_time_point()) {
-                deduct_from_sponsor (it->sponsor, it->quantity);
-                if (it->trigger_source == trigger_source_hypha_dao && it->trigger_event == trigger_event_golive) {
-                    pool_quantity += it->quantity;
-                } else {
-                    total_quantity += it->quantity;
-                }
-                it = locks_by_beneficiary.erase(it);
-            } else {
-                it++;
-            }
-        } else {
+            claimable = e_itr != e_t.end() && e_itr->event_date <= current_time_point();
+        }
+
+        if (!claimable) {
             it++;
+            continue;
         }
+
+        if (it->proposal_contract != name()) {
+            claimed_proposals.insert(std::make_pair(it->proposal_contract, it->proposal_id));
+        }
+
+        deduct_from_sponsor (it->sponsor, it->quantity);
+        if (it->lock_type == "event"_n && it->trigger_source == trigger_source_hypha_dao && it->trigger_event == trigger_event_golive) {
+            pool_quantity += it->quantity;
+        } else {
+            total_quantity += it->quantity;
+        }
+        it = locks_by_beneficiary.erase(it);
     }
 
     check(total_quantity > zero || pool_quantity > zero, 
         "vstandscrow: The beneficiary does not have any available locks, try to claim them after their vesting date or triggering event");
 
+    for (auto & proposal : claimed_proposals) {
+        send_proposal_done(proposal.first, proposal.second);
+    }
+
     if (total_quantity > zero) {
         send_transfer(beneficiary, total_quantity, string(""));
     }
@@ -414,3 +416,66 @@ void escrow::send_transfer (const name & beneficiary, const asset & quantity, co
 }
 
 
+
+// locks still in the old table are invisible to claim, cancellock and miglock
+void escrow::check_locks_migrated () {
+    legacy_token_lock_table legacy_locks(get_self(), get_self().value);
+    check(legacy_locks.begin() == legacy_locks.end(), "escrow: locks migration pending, run migratelocks first");
+}
+
+// campaign locks name their proposal in the notes, "proposal id: " for proposals and "proposal_id: " for dao,
+// notes without a readable id give no proposal instead of aborting migratelocks
+std::pair<name, uint64_t> escrow::get_proposal (const string & notes) {
+    name proposal_contract;
+
+    if (notes.find(string("proposal id: ")) != std::string::npos) {
+        proposal_contract = contracts::proposals;
+    } else if (notes.find(string("proposal_id: ")) != std::string::npos) {
+        proposal_contract = contracts::dao;
+    } else {
+        return std::make_pair(name(), uint64_t(0));
+    }
+
+    string id = notes.size() > 13 ? notes.substr(13, string::npos) : string("");
+    size_t digits = 0;
+    while (digits < id.size() && id[digits] >= '0' && id[digits] <= '9') {
+        digits++;
+    }
+
+    if (digits == 0 || digits > 9) {
+        return std::make_pair(name(), uint64_t(0));
+    }
+
+    return std::make_pair(proposal_contract, uint64_t(std::stoi(id.substr(0, digits))));
+}
+
+void escrow::send_proposal_done (const name & proposal_contract, const uint64_t & proposal_id) {
+    if (proposal_contract == contracts::proposals) {
+        action(
+            permission_level(contracts::proposals, "active"_n),
+            contracts::proposals,
+            "checkprop"_n,
+            std::make_tuple(proposal_id, string("proposal is not passing, lock can not be claimed"))
+        ).send();
+        action(
+            permission_level(contracts::proposals, "active"_n),
+            contracts::proposals,
+            "doneprop"_n,
+            std::make_tuple(proposal_id)
+        ).send();
+        return;
+    }
+
+    // this section is for dao.seeds
+    std::map<string, VariantValue> args = {
+        { "proposal_id", proposal_id },
+        { "action", name("doneprop") }
+    };
+
+    action(
+        permission_level(contracts::dao, "active"_n),
+        contracts::dao,
+        "callback"_n,
+        std::make_tuple(args)
+    ).send();
+}
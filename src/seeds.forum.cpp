@@ -393,46 +393,69 @@ ACTION forum::newday() {
 
 ACTION forum::rankforums() {
     uint64_t batch_size = config.get(name("batchsize").value, "The batchsize parameter has not been initialized yet").value;
-    rankforum(0, batch_size, 0);
+    rankforum(0, name(), 0, batch_size, 0);
 }
 
-ACTION forum::rankforum(uint64_t start, uint64_t chunksize, uint64_t chunk) {
+ACTION forum::rankforum(uint64_t start_rep, name start_account, uint64_t current, uint64_t chunksize, uint64_t available_points) {
     require_auth(get_self());
 
     uint64_t total = get_size(repsize);
     if (total == 0) return;
 
-    uint64_t current = chunk * chunksize;
     auto forum_rep_by_points = forumreps.get_index<"byrep"_n>();
-    auto fitr = start == 0 ? forum_rep_by_points.begin() : forum_rep_by_points.lower_bound(start);
+    auto fitr = forum_rep_by_points.lower_bound(start_rep);
+
+    auto sitr = start_account == name() ? forumreps.end() : forumreps.find(start_account.value);
+    if (sitr != forumreps.end() && sitr->by_reputation() == start_rep) {
+        fitr = forum_rep_by_points.iterator_to(*sitr);
+    } else {
+        // the next row is gone, rows with the same key are ordered by account so skip the ranked ones
+        while (fitr != forum_rep_by_points.end() && fitr->by_reputation() == start_rep && fitr->account < start_account) {
+            fitr++;
+        }
+    }
+
+    double multiplier = available_points / 4851.0;
+    std::vector<std::pair<name, int64_t>> reps;
     uint64_t count = 0;
 
     while (fitr != forum_rep_by_points.end() && count < chunksize) {
 
         uint64_t rank = utils::spline_rank(current, total);
 
-        forum_rep_by_points.modify(fitr, _self, [&](auto& item) {
-            item.rank = rank;
-        });
+        if (fitr->rank != rank) {
+            forum_rep_by_points.modify(fitr, _self, [&](auto& item) {
+                item.rank = rank;
+            });
+        }
+
+        uint64_t rep = std::min(multiplier * rank, 10.0);
+        if (rep > 0) {
+            reps.push_back(std::make_pair(fitr->account, int64_t(rep)));
+        }
 
         current++;
         count++;
         fitr++;
     }
 
+    if (!reps.empty()) {
+        action(
+            permission_level(contracts::accounts, "active"_n),
+            contracts::accounts,
+            "addreps"_n,
+            std::make_tuple(reps)
+        ).send();
+    }
+
     if (fitr != forum_rep_by_points.end()) {
-        uint64_t next_value = (fitr -> account).value;
-        action next_execution(
-            permission_level{get_self(), "active"_n},
+        utils::send_deferred_transaction(
+            get_self(),
+            permission_level(get_self(), "active"_n),
             get_self(),
             "rankforum"_n,
-            std::make_tuple(next_value, chunk + 1, chunksize)
+            std::make_tuple(fitr->by_reputation(), fitr->account, current, chunksize, available_points)
         );
-
-        transaction tx;
-        tx.actions.emplace_back(next_execution);
-        tx.delay_sec = 1;
-        tx.send(repsize.value, _self);
     }
 }
 
@@ -448,52 +471,14 @@ uint64_t forum::get_available_points() {
     return 0.1 * actives;
 }
 
+// ranks the forum again and gives rep from the fresh ranks in the same pass
 ACTION forum::givereps() {
     uint64_t batch_size = config.get(name("batchsize").value, "The batchsize parameter has not been initialized yet").value;
     uint64_t available_points = get_available_points();
-    giverep(0, batch_size, available_points);
+    rankforum(0, name(), 0, batch_size, available_points);
     delteactives();
 }
 
-ACTION forum::giverep(uint64_t start, uint64_t chunksize, uint64_t available_points) {
-    require_auth(get_self());
-
-    // uint64_t max_forum_rep = config.get(name("forum.maxrep").value, "The forum.maxrep parameter has not been initialized yet").value;
-    auto fitr = start == 0 ? forumreps.begin() : forumreps.find(start);
-    uint64_t count = 0;
-    double multiplier = available_points / 4851.0;
-
-    while (fitr != forumreps.end() && count < chunksize) {
-        uint64_t rep = std::min(multiplier * fitr -> rank, 10.0);
-        print("multiplier = ", multiplier, ", rank = ", fitr -> rank, ", result = ", rep, "\n");
-        if (rep > 0) {
-            action(
-                permission_level(contracts::accounts, "active"_n),
-                contracts::accounts,
-                "addrep"_n,
-                std::make_tuple(fitr -> account, rep)
-            ).send();
-        }
-        fitr++;
-        count++;
-    }
-
-    if (fitr != forumreps.end()) {
-        uint64_t next_value = (fitr -> account).value;
-        action next_execution(
-            permission_level{get_self(), "active"_n},
-            get_self(),
-            "giverep"_n,
-            std::make_tuple(next_value, chunksize, available_points)
-        );
-
-        transaction tx;
-        tx.actions.emplace_back(next_execution);
-        tx.delay_sec = 1;
-        tx.send(activesize.value, _self);
-    }
-}
-
 ACTION forum::delteactives() {
     uint64_t batch_size = config.get(name("batchsize").value, "The batchsize parameter has not been initialized yet").value;
     deleteactive(batch_size);
@@ -14,6 +14,16 @@ ACTION gratitude::reset () {
     actr = acks.erase(actr);
   }
 
+  auto aditr = ackdonors.begin();
+  while (aditr != ackdonors.end()) {
+    aditr = ackdonors.erase(aditr);
+  }
+
+  auto acitr = ackcounts.begin();
+  while (acitr != ackcounts.end()) {
+    acitr = ackcounts.erase(acitr);
+  }
+
   auto sitr = sizes.begin();
   while (sitr != sizes.end()) {
     sitr = sizes.erase(sitr);
@@ -88,15 +98,30 @@ ACTION gratitude::acknowledge (name from, name to, string memo) {
   init_balances(to);
   init_balances(from);
 
-  auto actr = acks.find(from.value);
-  if (actr == acks.end()) {
-    acks.emplace(_self, [&](auto& item) {
+  auto aditr = ackdonors.find(from.value);
+  if (aditr == ackdonors.end()) {
+    ackdonors.emplace(_self, [&](auto& item) {
+      item.donor = from;
+      item.num_acks = 1;
+    });
+  } else {
+    ackdonors.modify(aditr, _self, [&](auto& item) {
+      item.num_acks += 1;
+    });
+  }
+
+  auto acks_by_donor_receiver = ackcounts.get_index<"bydonorrec"_n>();
+  auto acitr = acks_by_donor_receiver.find((uint128_t(from.value) << 64) + to.value);
+  if (acitr == acks_by_donor_receiver.end()) {
+    ackcounts.emplace(_self, [&](auto& item) {
+      item.id = ackcounts.available_primary_key();
       item.donor = from;
-      item.receivers = vector{to};
+      item.receiver = to;
+      item.count = 1;
     });
   } else {
-    acks.modify(actr, get_self(), [&](auto &item) {
-        item.receivers.push_back(to);
+    acks_by_donor_receiver.modify(acitr, _self, [&](auto& item) {
+      item.count += 1;
     });
   }
 
@@ -116,36 +141,76 @@ ACTION gratitude::acknowledge (name from, name to, string memo) {
 ACTION gratitude::testacks() {
   require_auth(get_self());
 
-  auto actr = acks.begin();
+  auto min_acks = config_get(gratz_acks);
+  gratitude_deltas deltas;
 
-  while (actr != acks.end()) {
-    _calc_acks(actr->donor);
-    actr = acks.erase(actr);
+  while (acks.begin() != acks.end()) {
+    _calc_acks(acks.begin()->donor, min_acks, deltas);
   }
+
+  while (ackdonors.begin() != ackdonors.end()) {
+    _calc_acks(ackdonors.begin()->donor, min_acks, deltas);
+  }
+
+  flush_gratitude(deltas);
 }
 
+// Calculates up to batchsize donors, stopping before the donor that would take the batch over gratz.budget acks.
+// Donors are removed as they are calculated, so every call starts from the first one left and start is not read.
 ACTION gratitude::calcacks(uint64_t start) {
   require_auth(get_self());
 
-  auto actr = start == 0 ? acks.begin() : acks.find(start);
+  auto batch_size = config_get("batchsize"_n);
+  auto ack_budget = config_get(gratz_budget);
+  auto min_acks = config_get(gratz_acks);
 
-  if (actr != acks.end()) {
-    _calc_acks(actr->donor);
-    actr = acks.erase(actr);
+  gratitude_deltas deltas;
+  uint64_t donors = 0;
+  uint64_t num_acks = 0;
+
+  auto next_donor = [&]() {
+    if (acks.begin() != acks.end()) { return acks.begin()->donor; }
+    if (ackdonors.begin() != ackdonors.end()) { return ackdonors.begin()->donor; }
+    return name();
+  };
+
+  auto donor_acks = [&](name donor) {
+    uint64_t count = 0;
+    auto aditr = ackdonors.find(donor.value);
+    if (aditr != ackdonors.end()) { count += aditr->num_acks; }
+    auto actr = acks.find(donor.value);
+    if (actr != acks.end()) { count += actr->receivers.size(); }
+    return count;
+  };
+
+  name donor = next_donor();
+
+  while (donor != name() && donors < batch_size) {
+    // the first donor is always calculated, even when it alone is over the budget
+    if (donors > 0 && num_acks + donor_acks(donor) > ack_budget) {
+      break;
+    }
+
+    num_acks += _calc_acks(donor, min_acks, deltas);
+    donors++;
+    donor = next_donor();
   }
+
+  flush_gratitude(deltas);
+
   // If there is still more, do recursion call
-  if (actr != acks.end()) {
+  if (donor != name()) {
     action next_execution(
       permission_level{get_self(), "active"_n},
       get_self(),
       "calcacks"_n,
-      std::make_tuple(actr->donor.value)
+      std::make_tuple(donor.value)
     );
 
     transaction tx;
     tx.actions.emplace_back(next_execution);
     tx.delay_sec = 1;
-    tx.send(actr->donor.value, _self);
+    tx.send(donor.value, _self);
   } else {
     // Otherwise, starts recursive payout
     auto contract_balance = eosio::token::get_balance(contracts::token, get_self(), seeds_symbol.code());
@@ -259,38 +324,95 @@ void gratitude::check_user (name account) {
   check(uitr != users.end(), "gratitude: user not found");
 }
 
-void gratitude::_calc_acks (name donor) {
+// Adds the donor's acks to deltas and removes them, returns the number of acks
+uint64_t gratitude::_calc_acks (name donor, uint64_t min_acks, gratitude_deltas & deltas) {
   auto bitr = balances.find(donor.value);
   if (bitr == balances.end()) {
     init_balances(donor);
     bitr = balances.find(donor.value);
   }
 
+  // the donor's remaining only changes here, once per round, so pending deltas don't apply to it
   uint64_t remaining = bitr->remaining.amount;
 
-  auto min_acks = config_get(gratz_acks);
+  uint64_t num_acks = 0;
+
+  auto aditr = ackdonors.find(donor.value);
+  if (aditr != ackdonors.end()) {
+    num_acks += aditr->num_acks;
+  }
 
   auto actr = acks.find(donor.value);
+  if (actr != acks.end()) {
+    num_acks += actr->receivers.size();
+  }
+
+  uint64_t split = num_acks < min_acks ? min_acks : num_acks;
+
+  auto add_received = [&](name receiver, uint64_t count) {
+    uint64_t received = (remaining / split) * count;
+
+    deltas.balances[donor].given += received;
+    deltas.balances[receiver].received += received;
+    deltas.volume += received;
+    deltas.num_transfers++;
+  };
+
+  auto acks_by_donor_receiver = ackcounts.get_index<"bydonorrec"_n>();
+  auto acitr = acks_by_donor_receiver.lower_bound(uint128_t(donor.value) << 64);
+
+  while (acitr != acks_by_donor_receiver.end() && acitr->donor == donor) {
+    add_received(acitr->receiver, acitr->count);
+    acitr = acks_by_donor_receiver.erase(acitr);
+  }
+
+  // acks from before ackcounts
   if (actr != acks.end()) {
     std::map<name, uint64_t> unique_recs;
     for (std::size_t i = 0; i < actr->receivers.size(); i++) {
       unique_recs[actr->receivers[i]]++;
     }
-    auto uritr = unique_recs.begin();
-    while (uritr != unique_recs.end()) {
-      uint64_t received = 0;
-      if (actr->receivers.size() < min_acks) {
-        received = (remaining / min_acks) * uritr->second;
-      } else {
-        received = (remaining / actr->receivers.size()) * uritr->second;
-      }
+    for (const auto & [receiver, count] : unique_recs) {
+      add_received(receiver, count);
+    }
+    acks.erase(actr);
+  }
 
-      sub_gratitude(donor, asset(received, gratitude_symbol));
-      add_gratitude(uritr->first, asset(received, gratitude_symbol));
-      update_stats(donor, uritr->first, asset(received, gratitude_symbol));
-      uritr++;
+  if (aditr != ackdonors.end()) {
+    ackdonors.erase(aditr);
+  }
+
+  return num_acks;
+}
+
+// Writes the deltas accumulated by _calc_acks, each balance and the round stats once
+void gratitude::flush_gratitude (const gratitude_deltas & deltas) {
+  for (const auto & [account, delta] : deltas.balances) {
+    auto bitr = balances.find(account.value);
+    if (bitr == balances.end()) {
+      init_balances(account);
+      bitr = balances.find(account.value);
     }
+
+    check(bitr->remaining.amount >= delta.given, "gratitude: not enough gratitude to give");
+
+    balances.modify(bitr, _self, [&](auto & item){
+      item.remaining -= asset(delta.given, gratitude_symbol);
+      item.received += asset(delta.received, gratitude_symbol);
+    });
   }
+
+  if (deltas.num_transfers == 0) {
+    return;
+  }
+
+  auto round_id = stats2.rbegin()->round_id;
+  auto stitr = stats2.find(round_id);
+
+  stats2.modify(stitr, _self, [&](auto& item) {
+    item.volume += asset(deltas.volume, gratitude_symbol);
+    item.num_transfers += deltas.num_transfers;
+  });
 }
 
 uint64_t gratitude::get_current_volume() {
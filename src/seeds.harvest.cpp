@@ -68,6 +68,13 @@ void harvest::reset() {
     bcsitr = regioncstemp.erase(bcsitr);
   }
 
+  utils::delete_table<cs_pending_tables>(get_self(), individual_scope_harvest.value);
+  utils::delete_table<cs_pending_tables>(get_self(), organization_scope.value);
+  utils::delete_table<rank_lock_tables>(get_self(), get_self().value);
+
+  rank_cursor_tables rankcursor(get_self(), get_self().value);
+  rankcursor.remove();
+
   total.remove();
 
   init_balance(_self);
@@ -339,16 +346,39 @@ uint32_t harvest::calc_transaction_points(name account, name type) {
 
   transaction_points_tables transactions(contracts::history, account.value);
 
+  trx_window_tables trxwindows(contracts::history, contracts::history.value);
+  auto witr = trxwindows.find(account.value);
+
   uint64_t count = 0;
   uint64_t total_points = 0;
 
-  auto titr = transactions.rbegin();
-  while (titr != transactions.rend() && titr -> timestamp >= cutoffdate) {
+  if (witr != trxwindows.end()) {
+    // history keeps a running sum, only walk the days its expiry pass has not removed yet
+    total_points = witr -> points;
 
-    total_points += titr -> points;
+    auto titr = transactions.lower_bound(witr -> window_start);
+    while (titr != transactions.end() && titr -> timestamp < cutoffdate) {
+      total_points -= titr -> points;
+      titr++;
+      count++;
+    }
 
-    titr++;
-    count++;
+    // cyctrx.trail was made longer than the window
+    titr = transactions.lower_bound(cutoffdate);
+    while (titr != transactions.end() && titr -> timestamp < witr -> window_start) {
+      total_points += titr -> points;
+      titr++;
+      count++;
+    }
+  } else {
+    auto titr = transactions.rbegin();
+    while (titr != transactions.rend() && titr -> timestamp >= cutoffdate) {
+
+      total_points += titr -> points;
+
+      titr++;
+      count++;
+    }
   }
 
   if (type == name("organisation")) {
@@ -429,6 +459,7 @@ void harvest::ranktx(uint64_t start_val, uint64_t chunk, uint64_t chunksize, nam
 
   auto s = table == "org"_n ? org_tx_points_size : tx_points_size;
   uint64_t total = get_size(s);
+  BENCH_READ(1);
   if (total == 0) return;
 
   tx_points_tables txpoints_table(get_self(), table.value);
@@ -437,10 +468,14 @@ void harvest::ranktx(uint64_t start_val, uint64_t chunk, uint64_t chunksize, nam
   auto txpt_by_points = txpoints_table.get_index<"bypoints"_n>();
   auto titr = start_val == 0 ? txpt_by_points.begin() : txpt_by_points.lower_bound(start_val);
   uint64_t count = 0;
+  BENCH_SECONDARY(1);
 
   while (titr != txpt_by_points.end() && count < chunksize) {
 
     uint64_t rank = utils::spline_rank(current, total);
+    BENCH_READ(1);
+    BENCH_WRITE(1);
+    BENCH_SECONDARY(titr->rank != rank ? 2 : 1);
 
     txpt_by_points.modify(titr, _self, [&](auto& item) {
       item.rank = rank;
@@ -451,6 +486,8 @@ void harvest::ranktx(uint64_t start_val, uint64_t chunk, uint64_t chunksize, nam
     titr++;
   }
 
+  BENCH_PRINT();
+
   if (titr == txpt_by_points.end()) {
     // Done.
   } else {
@@ -480,16 +517,21 @@ void harvest::rankplanted(uint128_t start_val, uint64_t chunk, uint64_t chunksiz
   require_auth(_self);
 
   uint64_t total = get_size(planted_size);
+  BENCH_READ(1);
   if (total == 0) return;
 
   uint64_t current = chunk * chunksize;
   auto planted_by_planted = planted.get_index<"byplanted"_n>();
   auto pitr = start_val == 0 ? planted_by_planted.begin() : planted_by_planted.lower_bound(start_val);
   uint64_t count = 0;
+  BENCH_SECONDARY(1);
 
   while (pitr != planted_by_planted.end() && count < chunksize) {
 
     uint64_t rank = utils::spline_rank(current, total);
+    BENCH_READ(1);
+    BENCH_WRITE(1);
+    BENCH_SECONDARY(pitr->rank != rank ? 2 : 1);
 
     planted_by_planted.modify(pitr, _self, [&](auto& item) {
       item.rank = rank;
@@ -500,6 +542,8 @@ void harvest::rankplanted(uint128_t start_val, uint64_t chunk, uint64_t chunksiz
     pitr++;
   }
 
+  BENCH_PRINT();
+
   if (pitr == planted_by_planted.end()) {
     // Done.
   } else {
@@ -533,13 +577,17 @@ void harvest::calccs(uint64_t start_val, uint64_t chunk, uint64_t chunksize) {
   uint64_t total = utils::get_users_size();
   auto uitr = start_val == 0 ? users.begin() : users.lower_bound(start_val);
   uint64_t count = 0;
+  BENCH_READ(1);
 
   while (uitr != users.end() && count < chunksize) {
+    BENCH_READ(1);
     calc_contribution_score(uitr->account, uitr->type);
     count++;
     uitr++;
   }
 
+  BENCH_PRINT();
+
   if (uitr == users.end()) {
     // done
   } else {
@@ -567,30 +615,30 @@ void harvest::calc_contribution_score(name account, name type) {
 
   auto pitr = planted.find(account.value);
   if (pitr != planted.end()) planted_score = pitr->rank;
+  BENCH_READ(1);
 
   // CS scrore for org needs to be calculated differently
   // Page 71 constitution
 
   name scope;
   name cs_scope;
-  name cs_sz;
 
   if (type == "organisation"_n) {
     scope = organization_scope;
     cs_scope = scope;
-    cs_sz = cs_org_size;
     
     tx_points_tables orgtxpoints(get_self(), "org"_n.value);
     auto titr = orgtxpoints.find(account.value);
     if (titr != orgtxpoints.end()) transactions_score = titr->rank;
+    BENCH_READ(1);
 
   } else {
     scope = individual_scope_accounts;
     cs_scope = individual_scope_harvest;
-    cs_sz = cs_size;
 
     auto titr = txpoints.find(account.value);
     if (titr != txpoints.end()) transactions_score = titr->rank;
+    BENCH_READ(1);
   }
 
   rep_tables rep_t(contracts::accounts, scope.value);
@@ -600,6 +648,7 @@ void harvest::calc_contribution_score(name account, name type) {
   cbs_tables cbs_t(contracts::accounts, scope.value);
   auto citr = cbs_t.find(account.value);
   if (citr != cbs_t.end()) community_building_score = citr->rank;
+  BENCH_READ(2);
 
   // TODO verify this as correct for the constitution pp 71
   // Orgs need to have different scope for rep
@@ -610,9 +659,40 @@ void harvest::calc_contribution_score(name account, name type) {
 
   uint64_t contribution_points = ( (planted_score + transactions_score + community_building_score) * reputation_score * 2) / 100;
 
+  BENCH_READ(1);
+  if (utils::is_rank_locked(get_self(), cs_scope)) {
+    // rankcs is walking this scope, keep the ranked values stable until it's done
+    cs_pending_tables cspending(get_self(), cs_scope.value);
+
+    auto pitr = cspending.find(account.value);
+    BENCH_READ(1);
+    BENCH_WRITE(1);
+    if (pitr == cspending.end()) {
+      cspending.emplace(_self, [&](auto& item) {
+        item.account = account;
+        item.contribution_points = contribution_points;
+      });
+    } else {
+      cspending.modify(pitr, _self, [&](auto& item) {
+        item.contribution_points = contribution_points;
+      });
+    }
+  } else {
+    set_cs_points(account, cs_scope, contribution_points);
+  }
+
+  if (type != "organisation"_n) {
+    add_cs_to_region(account, uint32_t(contribution_points));
+  }
+}
+
+void harvest::set_cs_points(name account, name cs_scope, uint64_t contribution_points) {
+  name cs_sz = cs_scope == organization_scope ? cs_org_size : cs_size;
+
   cs_points_tables cspoints_t(get_self(), cs_scope.value);
 
   auto csitr = cspoints_t.find(account.value);
+  BENCH_READ(1);
   if (csitr == cspoints_t.end()) {
     if (contribution_points > 0) {
       cspoints_t.emplace(_self, [&](auto& item) {
@@ -620,28 +700,68 @@ void harvest::calc_contribution_score(name account, name type) {
         item.contribution_points = contribution_points;
       });
       size_change(cs_sz, 1);
+      BENCH_READ(1);
+      BENCH_WRITE(2);
+      BENCH_SECONDARY(2);
     }
   } else {
     if (contribution_points > 0) {
+      BENCH_WRITE(1);
+      BENCH_SECONDARY(csitr->contribution_points != contribution_points ? 1 : 0);
       cspoints_t.modify(csitr, _self, [&](auto& item) {
         item.contribution_points = contribution_points;
       });
     } else {
       cspoints_t.erase(csitr);
       size_change(cs_sz, -1);
+      BENCH_READ(1);
+      BENCH_WRITE(2);
+      BENCH_SECONDARY(2);
     }
   }
+}
 
-  if (type != "organisation"_n) {
-    add_cs_to_region(account, uint32_t(contribution_points));
+void harvest::mergecs(name cs_scope, uint64_t chunksize) {
+  require_auth(get_self());
+
+  // a new ranking started - its own merge picks up the remaining points
+  if (utils::is_rank_locked(get_self(), cs_scope)) return;
+
+  cs_pending_tables cspending(get_self(), cs_scope.value);
+
+  auto pitr = cspending.begin();
+  uint64_t count = 0;
+
+  while (pitr != cspending.end() && count < chunksize) {
+    set_cs_points(pitr->account, cs_scope, pitr->contribution_points);
+    pitr = cspending.erase(pitr);
+    count++;
+  }
+
+  if (pitr != cspending.end()) {
+    send_merge_cs(cs_scope, chunksize);
   }
 }
 
+void harvest::send_merge_cs(name cs_scope, uint64_t chunksize) {
+  utils::send_deferred_transaction(
+    get_self(),
+    permission_level(get_self(), "active"_n),
+    get_self(),
+    "mergecs"_n,
+    std::make_tuple(cs_scope, chunksize)
+  );
+}
+
 void harvest::add_cs_to_region(name account, uint32_t points) {
   auto bitr = members.find(account.value);
+  BENCH_READ(1);
   if (bitr == members.end()) { return; }
 
   auto csitr = regioncstemp.find(bitr -> region.value);
+  BENCH_READ(1);
+  BENCH_WRITE(points > 0 || csitr != regioncstemp.end() ? 1 : 0);
+  BENCH_SECONDARY(points > 0 || csitr != regioncstemp.end() ? 1 : 0);
   if (csitr == regioncstemp.end()) {
     if (points > 0) {
       regioncstemp.emplace(_self, [&](auto & item){
@@ -649,6 +769,8 @@ void harvest::add_cs_to_region(name account, uint32_t points) {
         item.points = points;
       });
       size_change(cs_rgn_size, 1);
+      BENCH_READ(1);
+      BENCH_WRITE(1);
     }
   } else {
     if (points > 0) {
@@ -683,8 +805,11 @@ void harvest::rankcs(uint64_t start_val, uint64_t chunk, uint64_t chunksize, nam
     total = get_size(cs_org_size);
     sum_rank_name = sum_rank_orgs;
   }
+  BENCH_READ(1);
   if (total == 0) return;
 
+  utils::rank_lock(get_self(), cs_scope);
+
   cs_points_tables cspoints_t(get_self(), cs_scope.value);
 
   uint64_t current = chunk * chunksize;
@@ -694,10 +819,15 @@ void harvest::rankcs(uint64_t start_val, uint64_t chunk, uint64_t chunksize, nam
   uint64_t sum_rank = 0;
 
   uint64_t min_eligible = config_get(name("org.minharv"));
+  BENCH_READ(2);
+  BENCH_SECONDARY(1);
 
   while (citr != cs_by_points.end() && count < chunksize) {
 
     uint64_t rank = utils::linear_rank(current, total);
+    BENCH_READ(1);
+    BENCH_WRITE(1);
+    BENCH_SECONDARY(citr->rank != rank ? 2 : 1);
 
     cs_by_points.modify(citr, _self, [&](auto& item) {
       item.rank = rank;
@@ -705,6 +835,7 @@ void harvest::rankcs(uint64_t start_val, uint64_t chunk, uint64_t chunksize, nam
 
     if (cs_scope == organization_scope) {
       auto org = organizations.find(citr -> account.value);
+      BENCH_READ(1);
       if (org -> status >= min_eligible) {
         sum_rank += rank;    
       }   
@@ -718,9 +849,13 @@ void harvest::rankcs(uint64_t start_val, uint64_t chunk, uint64_t chunksize, nam
   }
 
   size_change(sum_rank_name, int64_t(sum_rank));
+  BENCH_READ(1);
+  BENCH_WRITE(1);
+  BENCH_PRINT();
 
   if (citr == cs_by_points.end()) {
-    // Done.
+    utils::rank_unlock(get_self(), cs_scope);
+    mergecs(cs_scope, chunksize);
   } else {
     // recursive call
     uint64_t next_value = citr->by_cs_points();
@@ -741,6 +876,143 @@ void harvest::rankcs(uint64_t start_val, uint64_t chunk, uint64_t chunksize, nam
 }
 
 
+void harvest::rankalls() {
+  require_auth(get_self());
+
+  cancel_deferred("rankall"_n.value);
+
+  rank_cursor_tables rankcursor(get_self(), get_self().value);
+  rank_cursor_table rc = rank_cursor_table();
+  rc.phase = rank_phase_planted_tx;
+  rc.planted_total = get_size(planted_size);
+  rc.tx_total = get_size(tx_points_size);
+  rankcursor.set(rc, get_self());
+
+  rankall(200);
+}
+
+// Runs rankplanted + ranktx, calccs and rankcs for individuals as one chain.
+// Planted and tx ranks are written in the same pass, and each chunk moves on to the
+// next phase as soon as the previous one is finished, sharing one row budget.
+void harvest::rankall(uint64_t chunksize) {
+  require_auth(get_self());
+
+  check(chunksize > 0, "chunk size must be > 0");
+
+  rank_cursor_tables rankcursor(get_self(), get_self().value);
+  check(rankcursor.exists(), "ranking has not been started");
+  rank_cursor_table rc = rankcursor.get();
+
+  uint64_t count = 0;
+
+  if (rc.phase == rank_phase_planted_tx) {
+    auto planted_by_planted = planted.get_index<"byplanted"_n>();
+    auto pitr = rc.planted_current == 0 ? planted_by_planted.begin() : planted_by_planted.lower_bound(rc.planted_start);
+    if (rc.planted_total == 0) pitr = planted_by_planted.end();
+
+    auto txpt_by_points = txpoints.get_index<"bypoints"_n>();
+    auto titr = rc.tx_current == 0 ? txpt_by_points.begin() : txpt_by_points.lower_bound(rc.tx_start);
+    if (rc.tx_total == 0) titr = txpt_by_points.end();
+
+    while ((pitr != planted_by_planted.end() || titr != txpt_by_points.end()) && count < chunksize) {
+
+      if (pitr != planted_by_planted.end()) {
+        uint64_t rank = utils::spline_rank(rc.planted_current, rc.planted_total);
+        planted_by_planted.modify(pitr, _self, [&](auto& item) {
+          item.rank = rank;
+        });
+        rc.planted_current++;
+        count++;
+        pitr++;
+      }
+
+      if (titr != txpt_by_points.end()) {
+        uint64_t rank = utils::spline_rank(rc.tx_current, rc.tx_total);
+        txpt_by_points.modify(titr, _self, [&](auto& item) {
+          item.rank = rank;
+        });
+        rc.tx_current++;
+        count++;
+        titr++;
+      }
+    }
+
+    if (pitr != planted_by_planted.end()) rc.planted_start = pitr->by_planted();
+    if (titr != txpt_by_points.end()) rc.tx_start = titr->by_points();
+
+    if (pitr == planted_by_planted.end() && titr == txpt_by_points.end()) {
+      rc.phase = rank_phase_calc_cs;
+    }
+  }
+
+  if (rc.phase == rank_phase_calc_cs) {
+    auto uitr = rc.users_start == 0 ? users.begin() : users.lower_bound(rc.users_start);
+
+    while (uitr != users.end() && count < chunksize) {
+      calc_contribution_score(uitr->account, uitr->type);
+      count++;
+      uitr++;
+    }
+
+    if (uitr == users.end()) {
+      rc.phase = rank_phase_rank_cs;
+      rc.cs_total = get_size(cs_size);
+      size_set(sum_rank_users, 0);
+      utils::rank_lock(get_self(), individual_scope_harvest);
+    } else {
+      rc.users_start = uitr->account.value;
+    }
+  }
+
+  if (rc.phase == rank_phase_rank_cs) {
+    utils::rank_lock(get_self(), individual_scope_harvest);
+
+    auto cs_by_points = cspoints.get_index<"bycspoints"_n>();
+    auto citr = rc.cs_current == 0 ? cs_by_points.begin() : cs_by_points.lower_bound(rc.cs_start);
+    if (rc.cs_total == 0) citr = cs_by_points.end();
+
+    uint64_t sum_rank = 0;
+
+    while (citr != cs_by_points.end() && count < chunksize) {
+      uint64_t rank = utils::linear_rank(rc.cs_current, rc.cs_total);
+      cs_by_points.modify(citr, _self, [&](auto& item) {
+        item.rank = rank;
+      });
+      sum_rank += rank;
+      rc.cs_current++;
+      count++;
+      citr++;
+    }
+
+    size_change(sum_rank_users, int64_t(sum_rank));
+
+    if (citr == cs_by_points.end()) {
+      rc.phase = rank_phase_done;
+      utils::rank_unlock(get_self(), individual_scope_harvest);
+      mergecs(individual_scope_harvest, chunksize);
+    } else {
+      rc.cs_start = citr->by_cs_points();
+    }
+  }
+
+  rc.chunk++;
+  rankcursor.set(rc, get_self());
+
+  if (rc.phase != rank_phase_done) {
+    action next_execution(
+        permission_level{get_self(), "active"_n},
+        get_self(),
+        "rankall"_n,
+        std::make_tuple(chunksize)
+    );
+
+    transaction tx;
+    tx.actions.emplace_back(next_execution);
+    tx.delay_sec = 1;
+    tx.send("rankall"_n.value, _self);
+  }
+}
+
 void harvest::rankrgncss() {
   uint64_t batch_size = config_get("batchsize"_n);
   size_set(sum_rank_rgns, 0);
@@ -957,6 +1229,53 @@ void harvest::testupdatecs(name account, uint64_t contribution_score) {
   }
 }
 
+#ifdef SEEDS_BENCHMARK
+// Fills planted, txpoints and cspoints with synthetic accounts so the ranking
+// chains can be measured at realistic table sizes - see scripts/benchmark.harvest.js
+void harvest::testseed(uint64_t start, uint64_t count) {
+  require_auth(get_self());
+
+  uint64_t new_planted = 0;
+  uint64_t new_txpoints = 0;
+  uint64_t new_cspoints = 0;
+
+  for (uint64_t i = start; i < start + count; i++) {
+    name account = name(bench_account_base.value + i);
+
+    if (planted.find(account.value) == planted.end()) {
+      planted.emplace(_self, [&](auto& item) {
+        item.account = account;
+        item.planted = asset(((i * 7919) % 100000 + 1) * 10000, seeds_symbol);
+        item.rank = 0;
+      });
+      new_planted++;
+    }
+
+    if (txpoints.find(account.value) == txpoints.end()) {
+      txpoints.emplace(_self, [&](auto& item) {
+        item.account = account;
+        item.points = (i * 104729) % 5000 + 1;
+        item.rank = 0;
+      });
+      new_txpoints++;
+    }
+
+    if (cspoints.find(account.value) == cspoints.end()) {
+      cspoints.emplace(_self, [&](auto& item) {
+        item.account = account;
+        item.contribution_points = (i * 1299709) % 10000 + 1;
+        item.rank = 0;
+      });
+      new_cspoints++;
+    }
+  }
+
+  size_change(planted_size, new_planted);
+  size_change(tx_points_size, new_txpoints);
+  size_change(cs_size, new_cspoints);
+}
+#endif
+
 double harvest::get_rep_multiplier(name account) {
   //return 1.0;  // DEBUg FOR TESTINg otherwise everyone on testnet has 0
   return utils::get_rep_multiplier(account);
@@ -1005,6 +1324,19 @@ uint64_t harvest::get_size(name id) {
   }
 }
 
+// what pool::payouts can pay out, total.sz still holds amounts already paid by the payout index
+int64_t harvest::get_pool_balance() {
+  size_tables pool_sizes_t(contracts::pool, contracts::pool.value);
+
+  auto total_itr = pool_sizes_t.find(name("total.sz").value);
+  if (total_itr == pool_sizes_t.end()) { return 0; }
+
+  auto unsettled_itr = pool_sizes_t.find(name("unsettled.sz").value);
+  int64_t unsettled = unsettled_itr != pool_sizes_t.end() ? int64_t(unsettled_itr->size) : 0;
+
+  return std::max(int64_t(total_itr->size) - unsettled, int64_t(0));
+}
+
 void harvest::change_total(bool add, asset quantity) {
   total_table tt = total.get_or_create(get_self(), total_table());
   if (tt.total_planted.amount == 0) {
@@ -1212,13 +1544,11 @@ void harvest::runharvest() {
   if (mitr -> mint_rate <= 0) { return; }
 
   asset quantity;
-  size_tables pool_sizes_t(contracts::pool, contracts::pool.value);
-
-  auto total_pool_balance_itr = pool_sizes_t.find(name("total.sz").value);
+  int64_t pool_balance = get_pool_balance();
   int64_t pool_payout = 0;
 
-  if (total_pool_balance_itr != pool_sizes_t.end() && total_pool_balance_itr->size > 0) {
-    pool_payout = std::min(int64_t(mitr->mint_rate * 0.5), int64_t(total_pool_balance_itr->size));
+  if (pool_balance > 0) {
+    pool_payout = std::min(int64_t(mitr->mint_rate * 0.5), pool_balance);
     send_pool_payout(asset(pool_payout, utils::seeds_symbol));
   }
 
@@ -1258,14 +1588,20 @@ void harvest::disthvstusrs (uint64_t start, uint64_t chunksize, asset total_amou
   check(sum_rank > 0, "the sum rank for users must be greater than zero");
 
   double fragment_seeds = total_amount.amount / double(sum_rank);
+
+  std::vector<token::transfer_entry> transfers;
   
   while (csitr != cspoints.end() && count < chunksize) {
 
     // auto uitr = users.find(csitr -> account.value);
     if (csitr->rank > 0) {
 
-      print("user:", csitr->account, ", rank:", csitr -> rank, ", amount:", asset(csitr -> rank * fragment_seeds, test_symbol), "\n");
-      withdraw_aux(get_self(), csitr->account, asset(csitr->rank * fragment_seeds, test_symbol), "harvest");
+      asset amount(csitr->rank * fragment_seeds, test_symbol);
+      print("user:", csitr->account, ", rank:", csitr -> rank, ", amount:", amount, "\n");
+
+      if (amount.amount > 0) {
+        transfers.push_back({ csitr->account, amount, "harvest" });
+      }
     
     }
 
@@ -1273,6 +1609,12 @@ void harvest::disthvstusrs (uint64_t start, uint64_t chunksize, asset total_amou
     count++;
   }
 
+  // one transfer for the whole chunk - recipients get a transfermany notification, not transfer
+  if (transfers.size() > 0) {
+    token::transfermany_action t_action{contracts::token, { get_self(), "active"_n }};
+    t_action.send(get_self(), transfers);
+  }
+
   if (csitr != cspoints.end()) {
     action next_execution(
       permission_level{get_self(), "active"_n},
@@ -1583,13 +1925,11 @@ void harvest::lgrunhrvst(logmap log_map) {
   }
 
   asset quantity;
-  size_tables pool_sizes_t(contracts::pool, contracts::pool.value);
-
-  auto total_pool_balance_itr = pool_sizes_t.find(name("total.sz").value);
+  int64_t pool_balance = get_pool_balance();
   int64_t pool_payout = 0;
 
-  if ( (total_pool_balance_itr != pool_sizes_t.end() && total_pool_balance_itr->size > 0) || pbitr != log_map.end() ) {
-    uint64_t poolb_size = (pbitr != log_map.end()) ? std::get<1>(pbitr->second) : total_pool_balance_itr->size;
+  if (pool_balance > 0 || pbitr != log_map.end()) {
+    uint64_t poolb_size = (pbitr != log_map.end()) ? std::get<1>(pbitr->second) : pool_balance;
     pool_payout = std::min(int64_t(mint_rate * 0.5), int64_t(poolb_size));
 
     logaction(log_group, name("runharvest"), "Total pool balance size: " + std::to_string(poolb_size));
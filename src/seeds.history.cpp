@@ -19,6 +19,11 @@ void history::reset(name account) {
     titr = transactions.erase(titr);
   }
 
+  auto witr = trxwindows.find(account.value);
+  if (witr != trxwindows.end()) {
+    trxwindows.erase(witr);
+  }
+
   qev_tables qevs(get_self(), account.value);
   auto qitr = qevs.begin();
   while (qitr != qevs.end()) {
@@ -63,6 +68,11 @@ void history::reset(name account) {
   while (ptrx_itr != ptrx_t.end()) {
     ptrx_itr = ptrx_t.erase(ptrx_itr);
   }
+
+  auto qitr_queue = trxqueue.begin();
+  while (qitr_queue != trxqueue.end()) {
+    qitr_queue = trxqueue.erase(qitr_queue);
+  }
 }
 
 void history::deldailytrx (uint64_t day) {
@@ -159,9 +169,81 @@ void history::trxentry(name from, name to, asset quantity) {
   }
 
   auto from_user = users.find(from.value);
+  
+  if (from_user == users.end()) {
+    return;
+  }
+
+  // points, volumes and totals are saved in batches by savetrxs
+  bool queue_was_empty = trxqueue.begin() == trxqueue.end();
+
+  add_trx_entry(
+    from, 
+    from_user -> type == "organisation"_n, 
+    to, 
+    quantity,
+    int64_t(config_get("qev.trx.cap"_n)),
+    int64_t(config_get("i.trx.max"_n)),
+    int64_t(config_get("org.trx.max"_n))
+  );
+
+  if (queue_was_empty && trxqueue.begin() != trxqueue.end()) {
+    send_save_trxs();
+  }
+}
+
+// same as trxentry for every (to[i], quantities[i]), sent once per token::transfermany
+void history::trxentries(name from, std::vector<name> to, std::vector<asset> quantities) {
+  require_auth(get_self());
+
+  check(to.size() == quantities.size(), "to and quantities must have the same size");
+
+  auto from_user = users.find(from.value);
+
+  if (from_user == users.end()) {
+    return;
+  }
+
+  bool from_is_organization = from_user -> type == "organisation"_n;
+  bool queue_was_empty = trxqueue.begin() == trxqueue.end();
+
+  int64_t transactions_cap = int64_t(config_get("qev.trx.cap"_n));
+  int64_t max_transaction_points_individuals = int64_t(config_get("i.trx.max"_n));
+  int64_t max_transaction_points_organizations = int64_t(config_get("org.trx.max"_n));
+
+  for (std::size_t i = 0; i < to.size(); i++) {
+    if (quantities[i].symbol != utils::seeds_symbol) {
+      continue;
+    }
+    add_trx_entry(
+      from, 
+      from_is_organization, 
+      to[i], 
+      quantities[i], 
+      transactions_cap, 
+      max_transaction_points_individuals, 
+      max_transaction_points_organizations
+    );
+  }
+
+  if (queue_was_empty && trxqueue.begin() != trxqueue.end()) {
+    send_save_trxs();
+  }
+}
+
+void history::add_trx_entry (
+  name from, 
+  bool from_is_organization, 
+  name to, 
+  asset quantity, 
+  int64_t transactions_cap, 
+  int64_t max_transaction_points_individuals, 
+  int64_t max_transaction_points_organizations
+) {
+
   auto to_user = users.find(to.value);
   
-  if (from_user == users.end() || to_user == users.end()) {
+  if (to_user == users.end()) {
     return;
   }
 
@@ -171,13 +253,8 @@ void history::trxentry(name from, name to, asset quantity) {
   uint64_t transaction_id = transactions.available_primary_key();
   uint64_t timestamp = eosio::current_time_point().sec_since_epoch();
 
-  bool from_is_organization = from_user -> type == "organisation"_n;
   bool to_is_organization = to_user -> type == "organisation"_n;
 
-  int64_t transactions_cap = int64_t(config_get("qev.trx.cap"_n));
-  int64_t max_transaction_points_individuals = int64_t(config_get("i.trx.max"_n));
-  int64_t max_transaction_points_organizations = int64_t(config_get("org.trx.max"_n));
-
   double from_capped_amount = (
     from_is_organization ? 
     std::min(max_transaction_points_organizations, quantity.amount) : 
@@ -197,54 +274,14 @@ void history::trxentry(name from, name to, asset quantity) {
     transaction.timestamp = timestamp;
   });
 
-  auto from_totals_itr = totals.find(from.value);
-
-  if (from_totals_itr != totals.end()) {
-    totals.modify(from_totals_itr, _self, [&](auto & item){
-      item.total_volume += quantity.amount;
-      item.total_number_of_transactions += 1;
-      item.total_outgoing_to_rep_orgs += ( to_is_organization ? 1 : 0 );
-    });
-  } else {
-    totals.emplace(_self, [&](auto & item){
-      item.account = from;
-      item.total_volume += quantity.amount;
-      item.total_number_of_transactions = 1;
-      item.total_incoming_from_rep_orgs = 0;
-      item.total_outgoing_to_rep_orgs = ( to_is_organization ? 1 : 0 );
-    });
-  }
-
-  if (from_is_organization) {
-    auto to_totals_itr = totals.find(to.value);
-    if (to_totals_itr != totals.end()) {
-      totals.modify(to_totals_itr, _self, [&](auto & item){
-        item.total_incoming_from_rep_orgs += 1;
-      });
-    } else {
-      totals.emplace(_self, [&](auto & item){
-        item.account = to;
-        item.total_volume = 0;
-        item.total_number_of_transactions = 0;
-        item.total_incoming_from_rep_orgs = 1;
-        item.total_outgoing_to_rep_orgs = 0;
-      });
-    }
-  }
-
-  uint64_t deferred_id = get_deferred_id();
-
-  action a(
-    permission_level{contracts::history, "active"_n},
-    get_self(),
-    "savepoints"_n,
-    std::make_tuple(transaction_id, timestamp)
-  );
-
-  transaction tx;
-  tx.actions.emplace_back(a);
-  tx.delay_sec = 1;
-  tx.send(deferred_id, _self);
+  trxqueue.emplace(_self, [&](auto & item){
+    item.id = trxqueue.available_primary_key();
+    item.day = day;
+    item.transaction_id = transaction_id;
+    item.from = from;
+    item.to = to;
+    item.volume = quantity.amount;
+  });
 }
 
 uint64_t history::get_deferred_id () {
@@ -328,19 +365,7 @@ void history::savepoints(uint64_t id, uint64_t timestamp) {
     save_from_metrics (from, from_points, qualifying_volume, day);
 
     if (uitr_to -> type == name("organisation")) {
-      transaction_points_tables trx_points_to(get_self(), to.value);
-      auto trx_itr_to = trx_points_to.find(day);
-
-      if (trx_itr_to != trx_points_to.end()) {
-        trx_points_to.modify(trx_itr_to, _self, [&](auto & item){
-          item.points += to_points;
-        });
-      } else {
-        trx_points_to.emplace(_self, [&](auto & item){
-          item.timestamp = day;
-          item.points = to_points;
-        });
-      }
+      save_trx_points(to, day, to_points);
     }
 
     if (uitr_from -> type != name("organisation")) {
@@ -357,25 +382,199 @@ void history::savepoints(uint64_t id, uint64_t timestamp) {
   send_trx_cbp_reward_action(from, to);
 }
 
+void history::savetrxs () {
+  require_auth(get_self());
+
+  uint64_t batch_size = config_get("htry.batch"_n);
+  uint64_t max_number_transactions = config_get("htry.trx.max"_n);
+
+  // summed over the batch and written once per account and day
+  std::map<std::pair<uint64_t, uint64_t>, int64_t> points;
+  std::map<std::pair<uint64_t, uint64_t>, int64_t> qualifying_volumes;
+  std::map<uint64_t, int64_t> total_qualifying_volumes;
+  std::map<uint64_t, totals_table> batch_totals;
+
+  auto add_totals = [&](name account, uint64_t volume, uint64_t number, uint64_t incoming, uint64_t outgoing) {
+    auto & item = batch_totals[account.value];
+    item.account = account;
+    item.total_volume += volume;
+    item.total_number_of_transactions += number;
+    item.total_incoming_from_rep_orgs += incoming;
+    item.total_outgoing_to_rep_orgs += outgoing;
+  };
+
+  processed_trx_tables ptrx_t(get_self(), get_self().value);
+  auto ptrx_t_by_timestamp_id = ptrx_t.get_index<"bytimestmpid"_n>();
+
+  uint64_t count = 0;
+  auto qitr = trxqueue.begin();
+
+  while (qitr != trxqueue.end() && count < batch_size) {
+    name from = qitr -> from;
+    name to = qitr -> to;
+    uint64_t day = qitr -> day;
+
+    auto uitr_from = users.find(from.value);
+    auto uitr_to = users.find(to.value);
+    bool from_is_organization = uitr_from != users.end() && uitr_from -> type == "organisation"_n;
+    bool to_is_organization = uitr_to != users.end() && uitr_to -> type == "organisation"_n;
+
+    add_totals(from, qitr -> volume, 1, 0, to_is_organization ? 1 : 0);
+    if (from_is_organization) {
+      add_totals(to, 0, 0, 1, 0);
+    }
+
+    daily_transactions_tables transactions(get_self(), day);
+    auto transactions_by_from_to = transactions.get_index<"byfromto"_n>();
+
+    // the entry is gone if a bigger transfer between the same accounts replaced it before it was saved
+    auto titr = transactions.find(qitr -> transaction_id);
+
+    if (titr != transactions.end()) {
+      uint128_t from_to_id = (uint128_t(from.value) << 64) + to.value;
+      uint64_t ft_count = 0;
+
+      auto ft_itr = transactions_by_from_to.find(from_to_id);
+      auto current_itr = ft_itr;
+
+      while (ft_itr != transactions_by_from_to.end() && 
+          ft_count <= max_number_transactions && 
+          ft_itr -> from == from && ft_itr -> to == to) {
+
+        if (ft_itr -> volume < current_itr -> volume) {
+          current_itr = ft_itr;
+        }
+
+        ft_itr++;
+        ft_count++;
+      }
+
+      int64_t from_points = int64_t(titr -> from_points);
+      int64_t to_points = int64_t(titr -> to_points);
+      int64_t qualifying_volume = int64_t(titr -> qualifying_volume);
+
+      bool save_points = true;
+
+      if (ft_count > max_number_transactions) {
+        if (current_itr -> id != titr -> id) {
+          uint128_t ptrx_id = (uint128_t(day) << 64) + current_itr -> id;
+
+          if (ptrx_t_by_timestamp_id.find(ptrx_id) != ptrx_t_by_timestamp_id.end()) {
+            from_points -= current_itr -> from_points;
+            to_points -= current_itr -> to_points;
+            qualifying_volume -= current_itr -> qualifying_volume;
+          }
+        } else {
+          save_points = false;
+        }
+
+        transactions_by_from_to.erase(current_itr);
+      }
+
+      if (save_points) {
+        points[{ from.value, day }] += from_points;
+        qualifying_volumes[{ from.value, day }] += qualifying_volume;
+        total_qualifying_volumes[day] += qualifying_volume;
+
+        if (to_is_organization) {
+          points[{ to.value, day }] += to_points;
+        }
+
+        ptrx_t.emplace(_self, [&](auto & ptrx){
+          ptrx.id = ptrx_t.available_primary_key();
+          ptrx.transaction_id = qitr -> transaction_id;
+          ptrx.timestamp = day;
+        });
+      }
+    }
+
+    send_cbp_rewards(from, to);
+
+    qitr = trxqueue.erase(qitr);
+    count++;
+  }
+
+  for (const auto & [key, value] : points) {
+    save_trx_points(name(key.first), key.second, value);
+  }
+
+  for (const auto & [key, value] : qualifying_volumes) {
+    qev_tables qevs(get_self(), key.first);
+    auto qev_itr = qevs.find(key.second);
+
+    if (qev_itr != qevs.end()) {
+      qevs.modify(qev_itr, _self, [&](auto & item){
+        item.qualifying_volume += value;
+      });
+    } else {
+      qevs.emplace(_self, [&](auto & item){
+        item.timestamp = key.second;
+        item.qualifying_volume = value;
+      });
+    }
+  }
+
+  qev_tables qevs_total(get_self(), get_self().value);
+
+  for (const auto & [day, value] : total_qualifying_volumes) {
+    auto qev_total_itr = qevs_total.find(day);
+
+    if (qev_total_itr != qevs_total.end()) {
+      qevs_total.modify(qev_total_itr, _self, [&](auto & item){
+        item.qualifying_volume += value;
+      });
+    } else {
+      qevs_total.emplace(_self, [&](auto & item){
+        item.timestamp = day;
+        item.qualifying_volume = value;
+      });
+    }
+  }
+
+  for (const auto & [account, batch] : batch_totals) {
+    auto titr = totals.find(account);
+
+    if (titr != totals.end()) {
+      totals.modify(titr, _self, [&](auto & item){
+        item.total_volume += batch.total_volume;
+        item.total_number_of_transactions += batch.total_number_of_transactions;
+        item.total_incoming_from_rep_orgs += batch.total_incoming_from_rep_orgs;
+        item.total_outgoing_to_rep_orgs += batch.total_outgoing_to_rep_orgs;
+      });
+    } else {
+      totals.emplace(_self, [&](auto & item){
+        item = batch;
+      });
+    }
+  }
+
+  if (qitr != trxqueue.end()) {
+    send_save_trxs();
+  }
+}
+
+void history::send_save_trxs () {
+  action a(
+    permission_level{get_self(), "active"_n},
+    get_self(),
+    "savetrxs"_n,
+    std::make_tuple()
+  );
+
+  transaction tx;
+  tx.actions.emplace_back(a);
+  tx.delay_sec = 1;
+  tx.send("savetrxs"_n.value, _self, true); // at most one pending batch
+}
+
 void history::save_from_metrics (name from, int64_t & from_points, int64_t & qualifying_volume, uint64_t & day) {
-  transaction_points_tables trx_points_from(get_self(), from.value);
   qev_tables qevs(get_self(), from.value);
   qev_tables qevs_total(get_self(), get_self().value);
 
-  auto trx_itr = trx_points_from.find(day);
   auto qev_itr = qevs.find(day);
   auto qev_total_itr = qevs_total.find(day);
 
-  if (trx_itr != trx_points_from.end()) {
-    trx_points_from.modify(trx_itr, _self, [&](auto & item){
-      item.points += from_points;
-    });
-  } else {
-    trx_points_from.emplace(_self, [&](auto & item){
-      item.timestamp = day;
-      item.points = from_points;
-    });
-  }
+  save_trx_points(from, day, from_points);
 
   if (qev_itr != qevs.end()) {
     qevs.modify(qev_itr, _self, [&](auto & item){
@@ -400,6 +599,113 @@ void history::save_from_metrics (name from, int64_t & from_points, int64_t & qua
   }
 }
 
+// Writes the day's trxpoints and keeps the account's running window sum in step,
+// so harvest can read the trailing transaction points without walking every day
+void history::save_trx_points (name account, uint64_t day, int64_t points) {
+  transaction_points_tables trx_points(get_self(), account.value);
+  auto witr = trxwindows.find(account.value);
+
+  if (witr == trxwindows.end()) {
+    uint64_t cutoff = trx_window_cutoff();
+    uint64_t window_points = 0;
+
+    auto titr = trx_points.lower_bound(cutoff);
+    while (titr != trx_points.end()) {
+      window_points += titr -> points;
+      titr++;
+    }
+
+    witr = trxwindows.emplace(_self, [&](auto & item){
+      item.account = account;
+      item.points = window_points;
+      item.window_start = cutoff;
+    });
+  }
+
+  auto trx_itr = trx_points.find(day);
+
+  if (trx_itr != trx_points.end()) {
+    trx_points.modify(trx_itr, _self, [&](auto & item){
+      item.points += points;
+    });
+  } else {
+    trx_points.emplace(_self, [&](auto & item){
+      item.timestamp = day;
+      item.points = points;
+    });
+  }
+
+  if (day >= witr -> window_start) {
+    trxwindows.modify(witr, _self, [&](auto & item){
+      item.points += points;
+    });
+  }
+}
+
+uint64_t history::trx_window_cutoff () {
+  uint64_t now = eosio::current_time_point().sec_since_epoch();
+  return now - (utils::moon_cycle * config_float_get("cyctrx.trail"_n));
+}
+
+void history::expiretrxs () {
+  require_auth(get_self());
+  expiretrx(0, config_get("batchsize"_n));
+}
+
+// Subtracts the days that fell out of the trailing window since the last pass
+void history::expiretrx (uint64_t start, uint64_t chunksize) {
+  require_auth(get_self());
+
+  uint64_t cutoff = trx_window_cutoff();
+  uint64_t count = 0;
+
+  auto witr = start == 0 ? trxwindows.begin() : trxwindows.lower_bound(start);
+
+  while (witr != trxwindows.end() && count < chunksize) {
+    if (witr -> window_start < cutoff) {
+      transaction_points_tables trx_points(get_self(), witr -> account.value);
+
+      uint64_t expired_points = 0;
+      auto titr = trx_points.lower_bound(witr -> window_start);
+
+      while (titr != trx_points.end() && titr -> timestamp < cutoff) {
+        expired_points += titr -> points;
+        titr++;
+        count++;
+      }
+
+      if (titr == trx_points.end()) {
+        // nothing left in the window, save_trx_points starts a new one
+        witr = trxwindows.erase(witr);
+        count++;
+        continue;
+      }
+
+      trxwindows.modify(witr, _self, [&](auto & item){
+        item.points -= expired_points;
+        item.window_start = cutoff;
+      });
+    }
+
+    witr++;
+    count++;
+  }
+
+  if (witr != trxwindows.end()) {
+    action next_execution(
+      permission_level{get_self(), "active"_n},
+      get_self(),
+      "expiretrx"_n,
+      std::make_tuple(witr -> account.value, chunksize)
+    );
+
+    transaction tx;
+    tx.actions.emplace_back(next_execution);
+    tx.delay_sec = 1;
+    tx.send(get_deferred_id(), _self);
+  }
+}
+
 void history::send_trx_cbp_reward_action (name from, name to) {
 
   uint64_t deferred_id = get_deferred_id();
@@ -458,7 +764,10 @@ void history::trx_cbp_reward (name account, name key) {
 
 void history::sendtrxcbp (uint64_t deferred_id, name from, name to) {
   require_auth(get_self());
+  send_cbp_rewards(from, to);
+}
 
+void history::send_cbp_rewards (name from, name to) {
   auto oitr = organizations.find(to.value);
 
   if (oitr != organizations.end()) {
@@ -850,18 +1159,7 @@ void history::adjust_transactions (uint64_t id, uint64_t timestamp) {
   save_from_metrics(from, from_points, qualifying_volume, day);
   
   if (uitr_to -> type == name("organisation")) {
-    transaction_points_tables trx_points_to(get_self(), to.value);
-    auto trx_itr_to = trx_points_to.find(day);
-    if (trx_itr_to != trx_points_to.end()) {
-      trx_points_to.modify(trx_itr_to, _self, [&](auto & item){
-        item.points += to_points;
-      });
-    } else {
-      trx_points_to.emplace(_self, [&](auto & item){
-        item.timestamp = day;
-        item.points = to_points;
-      });
-    }
+    save_trx_points(to, day, to_points);
   }
 }
 
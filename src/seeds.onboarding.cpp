@@ -90,23 +90,13 @@ void onboarding::transfer_seeds(name account, asset quantity, string memo)
       .send();
 }
 
-void onboarding::plant_seeds(asset quantity)
-{
-  string memo("");
-
-  action(
-      permission_level{_self, "active"_n},
-      contracts::token, "transfer"_n,
-      make_tuple(_self, contracts::harvest, quantity, memo))
-      .send();
-}
-
+// planting with a "sow" memo plants straight into the account, no need to plant here and sow after
 void onboarding::sow_seeds(name account, asset quantity)
 {
   action(
       permission_level{_self, "active"_n},
-      contracts::harvest, "sow"_n,
-      make_tuple(_self, account, quantity))
+      contracts::token, "transfer"_n,
+      make_tuple(_self, contracts::harvest, quantity, string("sow ") + account.to_string()))
       .send();
 }
 
@@ -119,15 +109,6 @@ void onboarding::add_referral(name sponsor, name account)
       .send();
 }
 
-void onboarding::invitevouch(name sponsor, name account)
-{
-  action(
-      permission_level{contracts::accounts, "active"_n},
-      contracts::accounts, "invitevouch"_n,
-      make_tuple(sponsor, account))
-      .send();
-}
-
 void onboarding::send_campaign_reward(uint64_t campaign_id)
 {
   if (campaign_id == 0)
@@ -147,6 +128,15 @@ void onboarding::send_campaign_reward(uint64_t campaign_id)
 void onboarding::accept_invite(
     name account, checksum256 invite_secret, string publicKey, string fullname, bool is_existing_telos_account, bool is_plant_seeds)
 {
+  accepted_invite accepted = use_invite(account, invite_secret, publicKey, fullname, is_existing_telos_account);
+  onboard_users({accepted});
+  pay_invite(accepted, is_plant_seeds);
+}
+
+// marks the invite as accepted and creates the telos account, the seeds side is done by onboard_users and pay_invite
+onboarding::accepted_invite onboarding::use_invite(
+    name account, checksum256 invite_secret, string publicKey, string fullname, bool is_existing_telos_account)
+{
 
   auto _invite_secret = invite_secret.extract_as_byte_array();
   checksum256 invite_hash = sha256((const char *)_invite_secret.data(), _invite_secret.size());
@@ -173,9 +163,6 @@ void onboarding::accept_invite(
                           invite.invite_secret = invite_secret;
                         });
 
-  asset transfer_quantity = iitr->transfer_quantity;
-  asset sow_quantity = iitr->sow_quantity;
-
   bool is_existing_telos_user = is_account(account);
   bool is_existing_seeds_user = is_seeds_user(account);
 
@@ -195,14 +182,44 @@ void onboarding::accept_invite(
     create_account(account, publicKey, ""_n);
   }
 
-  if (!is_existing_seeds_user)
+  return accepted_invite{
+      account,
+      referrer,
+      fullname,
+      !is_existing_seeds_user,
+      iitr->invite_id,
+      iitr->transfer_quantity,
+      iitr->sow_quantity};
+}
+
+// one accounts action registers all new users with their referral and invite vouch
+void onboarding::onboard_users(const std::vector<accepted_invite> & accepted)
+{
+  std::vector<std::tuple<name, name, string>> new_users;
+
+  for (const auto & item : accepted)
   {
-    add_user(account, fullname, "individual"_n);
-    add_referral(referrer, account);
-    invitevouch(referrer, account);
+    if (item.is_new_seeds_user)
+    {
+      new_users.push_back(std::make_tuple(item.referrer, item.account, item.fullname));
+    }
   }
 
-  auto ciitr = campinvites.find(iitr->invite_id);
+  if (new_users.empty())
+  {
+    return;
+  }
+
+  action(
+      permission_level{contracts::accounts, "active"_n},
+      contracts::accounts, "onboardusers"_n,
+      make_tuple(new_users))
+      .send();
+}
+
+void onboarding::pay_invite(const accepted_invite & accepted, bool is_plant_seeds)
+{
+  auto ciitr = campinvites.find(accepted.invite_id);
   if (ciitr != campinvites.end())
   {
     send_campaign_reward(ciitr->campaign_id);
@@ -210,13 +227,12 @@ void onboarding::accept_invite(
 
   if (is_plant_seeds)
   {
-    transfer_seeds(account, transfer_quantity, string("invite seeds"));
-    plant_seeds(sow_quantity);
-    sow_seeds(account, sow_quantity);
+    transfer_seeds(accepted.account, accepted.transfer_quantity, string("invite seeds"));
+    sow_seeds(accepted.account, accepted.sow_quantity);
   }
   else
   {
-    transfer_seeds(account, transfer_quantity + sow_quantity, string("invite seeds"));
+    transfer_seeds(accepted.account, accepted.transfer_quantity + accepted.sow_quantity, string("invite seeds"));
   }
 }
 
@@ -528,6 +544,30 @@ void onboarding::reward(name account, checksum256 invite_secret)
   accept_invite(account, invite_secret, string(""), string(""), true, false);
 }
 
+// bulk version of acceptnew for onboarding events, the accounts side is one action for the whole batch
+void onboarding::acceptbatch(std::vector<std::tuple<name, checksum256, string, string>> invites)
+{
+  require_auth(get_self());
+
+  check(invites.size() > 0, "no invites to accept");
+
+  std::vector<accepted_invite> accepted;
+  accepted.reserve(invites.size());
+
+  for (const auto & [account, invite_secret, publicKey, fullname] : invites)
+  {
+    check(is_account(account) == false, "Account already exists " + account.to_string());
+    accepted.push_back(use_invite(account, invite_secret, publicKey, fullname, false));
+  }
+
+  onboard_users(accepted);
+
+  for (const auto & item : accepted)
+  {
+    pay_invite(item, true);
+  }
+}
+
 void onboarding::chkcleanup()
 {
   require_auth(get_self());
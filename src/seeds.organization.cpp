@@ -162,6 +162,11 @@ ACTION organization::reset() {
         dsitr = dausscores.erase(dsitr);
     }
 
+    auto dwitr = dauswindow.begin();
+    while (dwitr != dauswindow.end()) {
+        dwitr = dauswindow.erase(dwitr);
+    }
+
     auto bitr = sponsors.begin();
     while(bitr != sponsors.end()){
         bitr = sponsors.erase(bitr);
@@ -652,6 +657,8 @@ ACTION organization::appuse (name appname, name account) {
     uint64_t points = uitr.status == "citizen"_n ? config_get("dau.cit.pt"_n) : config_get("dau.res.pt"_n);
     points *= utils::get_rep_multiplier(account);
 
+    uint64_t new_users = 0;
+
     if (ditr != daus_by_day_account.end()) {
         uint64_t max_uses = config_get("dau.maxuse"_n);
         if (ditr->number_app_uses < max_uses) {
@@ -662,8 +669,12 @@ ACTION organization::appuse (name appname, name account) {
             daus_totals.modify(dtitr, _self, [&](auto & item){
                 item.daily_points += points;
             });
+        } else {
+            return;
         }
     } else {
+        new_users = 1;
+
         daus.emplace(_self, [&](auto & item){
             item.id = daus.available_primary_key();
             item.account = account;
@@ -686,16 +697,22 @@ ACTION organization::appuse (name appname, name account) {
         }
 
     }
+
+    // apps without a window get one from daustotals the next time they are calculated
+    auto dwitr = dauswindow.find(appname.value);
+    if (dwitr != dauswindow.end()) {
+        dauswindow.modify(dwitr, _self, [&](auto & item){
+            item.points += points;
+            item.users += new_users;
+        });
+    }
 }
 
 ACTION organization::calcmappuses () {
     require_auth(get_self());
 
     uint64_t threshold = config_get("dau.thresh"_n);
-    uint64_t trailing_cycles = config_get("dau.cyc"_n);
-
-    uint64_t now = eosio::current_time_point().sec_since_epoch();
-    uint64_t cutoff = now - (trailing_cycles * utils::moon_cycle);
+    uint64_t cutoff = get_daus_cutoff();
 
     uint64_t batch_size = config_get("batchsize"_n);
 
@@ -739,20 +756,65 @@ ACTION organization::calcmappuse (uint64_t start, uint64_t chunksize, uint64_t t
     }
 }
 
-void organization::calculate_trailing_app_use (const name & appname, const uint64_t & cutoff, const int64_t & threshold) {
+uint64_t organization::get_daus_cutoff () {
+    uint64_t trailing_cycles = config_get("dau.cyc"_n);
+    uint64_t now = eosio::current_time_point().sec_since_epoch();
+    return now - (trailing_cycles * utils::moon_cycle);
+}
+
+// Moves the app's window up to cutoff, only the days that fell out of it since the last call are read
+void organization::expire_daus_window (const name & appname, const uint64_t & cutoff) {
 
     daus_totals_tables daus_totals(get_self(), appname.value);
 
-    int64_t trailing_points = 0;
-    uint64_t trailing_uses = 0;
+    auto dwitr = dauswindow.find(appname.value);
+    if (dwitr == dauswindow.end()) {
+        int64_t points = 0;
+        uint64_t users = 0;
 
-    auto dtitr = daus_totals.rbegin();
-    while (dtitr != daus_totals.rend() && dtitr->day >= cutoff) {
-        trailing_points += dtitr->daily_points;
-        trailing_uses += dtitr->daily_users;
+        auto dtitr = daus_totals.lower_bound(cutoff);
+        while (dtitr != daus_totals.end()) {
+            points += dtitr->daily_points;
+            users += dtitr->daily_users;
+            dtitr++;
+        }
+
+        dauswindow.emplace(_self, [&](auto & item){
+            item.app_name = appname;
+            item.points = points;
+            item.users = users;
+            item.start_day = cutoff;
+        });
+        return;
+    }
+
+    if (cutoff <= dwitr->start_day) { return; }
+
+    int64_t points = dwitr->points;
+    uint64_t users = dwitr->users;
+
+    auto dtitr = daus_totals.lower_bound(dwitr->start_day);
+    while (dtitr != daus_totals.end() && dtitr->day < cutoff) {
+        points -= dtitr->daily_points;
+        users -= dtitr->daily_users;
         dtitr++;
     }
 
+    dauswindow.modify(dwitr, _self, [&](auto & item){
+        item.points = points;
+        item.users = users;
+        item.start_day = cutoff;
+    });
+}
+
+void organization::calculate_trailing_app_use (const name & appname, const uint64_t & cutoff, const int64_t & threshold) {
+
+    expire_daus_window(appname, cutoff);
+
+    auto & window = dauswindow.get(appname.value);
+    int64_t trailing_points = window.points;
+    uint64_t trailing_uses = window.users;
+
     auto dsitr = dausscores.find(appname.value);
     if (dsitr != dausscores.end()) {
         if (trailing_points >= threshold) {
@@ -822,6 +884,58 @@ ACTION organization::rankappuse (uint128_t start, uint64_t chunk, uint64_t chunk
 
 }
 
+ACTION organization::cleandaus () {
+    require_auth(get_self());
+    uint64_t batch_size = config_get("batchsize"_n);
+    cleandau(uint64_t(0), batch_size, get_daus_cutoff());
+}
+
+ACTION organization::cleandau (uint64_t start, uint64_t chunksize, uint64_t cutoff) {
+    require_auth(get_self());
+
+    check(chunksize > 0, "chunk size must be > 0");
+
+    auto appitr = start == 0 ? apps.begin() : apps.find(start);
+    uint64_t count = 0;
+
+    while (appitr != apps.end() && count < chunksize) {
+        name appname = appitr->app_name;
+
+        // the window has to stop counting the days before their totals are deleted
+        expire_daus_window(appname, cutoff);
+
+        daus_tables daus(get_self(), appname.value);
+        auto daus_by_day_account = daus.get_index<"bydayacct"_n>();
+        auto ditr = daus_by_day_account.begin();
+        while (ditr != daus_by_day_account.end() && ditr->day < cutoff && count < chunksize) {
+            ditr = daus_by_day_account.erase(ditr);
+            count++;
+        }
+        if (ditr != daus_by_day_account.end() && ditr->day < cutoff) { break; }
+
+        daus_totals_tables daus_totals(get_self(), appname.value);
+        auto dtitr = daus_totals.begin();
+        while (dtitr != daus_totals.end() && dtitr->day < cutoff && count < chunksize) {
+            dtitr = daus_totals.erase(dtitr);
+            count++;
+        }
+        if (dtitr != daus_totals.end() && dtitr->day < cutoff) { break; }
+
+        appitr++;
+        count++;
+    }
+
+    if (appitr != apps.end()) {
+        utils::send_deferred_transaction(
+            get_self(),
+            permission_level(get_self(), "active"_n),
+            get_self(),
+            "cleandau"_n,
+            std::make_tuple((appitr->app_name).value, chunksize, cutoff)
+        );
+    }
+}
+
 ACTION organization::scoretrxs() {
     scoreorgs(""_n);
 }
@@ -18,6 +18,8 @@ ACTION pool::reset () {
   while (sitr != sizes.end()) {
     sitr = sizes.erase(sitr);
   }
+
+  payoutstate.remove();
 }
 
 
@@ -33,6 +35,7 @@ ACTION pool::ontransfer (name from, name to, asset quantity, string memo) {
     name account = name(memo);
     check(is_account(account), account.to_string() + " is not an account");
 
+    settle_account(account);
     add_balance(account, quantity, get_self());
     size_change(total_balance_size, quantity.amount);
   }}
@@ -49,10 +52,13 @@ void pool::update_pool_token( const name& owner, const asset& quantity, const sy
 void pool::add_balance( const name& owner, const asset& value, const name& ram_payer )
 {
    const auto& bal_to = balances.find( owner.value );
+   auto state = payoutstate.get_or_default();
    if( bal_to == balances.end() ) {
       balances.emplace( get_self(), [&]( auto& a ){
         a.account = owner;
         a.balance = value;
+        a.payout_index = state.index;
+        a.payout_epoch = state.epoch;
       });
       accounts acct(get_self(), owner.value);
       const auto& aitr = acct.find(utils::pool_symbol.raw());
@@ -70,6 +76,8 @@ void pool::add_balance( const name& owner, const asset& value, const name& ram_p
       new_balance.amount += value.amount;
       balances.modify( bal_to, same_payer, [&]( auto& a ) {
         a.balance.amount = new_balance.amount;
+        a.payout_index = state.index;
+        a.payout_epoch = state.epoch;
       });
       update_pool_token( owner, new_balance );
    }
@@ -102,74 +110,155 @@ ACTION pool::transfer(name from, name to, asset quantity, const string& memo)
 {
   check(quantity.symbol == utils::pool_symbol, "poolxfr: unknown token");
   quantity.symbol = utils::seeds_symbol;
-  auto& bal_from = balances.get(from.value, "poolxfr: unknown sender");
+  balances.get(from.value, "poolxfr: unknown sender");
   require_auth(from);
   check(is_account(to), "poolxfr: " + to.to_string() + " is not an account");
   check( quantity.amount > 0, "poolxfr: must transfer positive quantity" );
   check( memo.size() <= 256, "poolxfr: memo has more than 256 bytes" );
+  settle_account( from );
+  settle_account( to );
+  check( balances.find(from.value) != balances.end(), "poolxfr: overdrawn balance" );
   bool emptied = sub_balance( from, quantity );
-  if( emptied ) { balances.erase(bal_from); }
+  if( emptied ) { balances.erase(balances.find(from.value)); }
   name payer = get_self(); // TBD: make from acct pay ram, or a SEEDS fee?
   add_balance( to, quantity, payer );
 }
 
+// Only moves the payout index, holders get their share when they are settled - when their pool
+// tokens move, when they claim or by the settle pass
 ACTION pool::payouts (asset quantity) {
 
   require_auth(get_self());
 
-  uint64_t batch_size = config_get("batchsize"_n);
-  payout(quantity, uint64_t(0), batch_size, uint64_t(0));
+  int64_t total_balance = int64_t(get_size(total_balance_size)) - int64_t(get_size(unsettled_size));
 
-}
+  if (total_balance <= 0) { return; }
+  if (quantity.amount <= 0) { return; }
+  if (total_balance < quantity.amount) { return; }
+
+  auto state = payoutstate.get_or_default();
+
+  if (quantity.amount == total_balance) {
+    state.epoch += 1;
+    state.index = 0;
+  } else {
+    state.index += std::log(double(total_balance) / double(total_balance - quantity.amount));
+  }
+
+  payoutstate.set(state, get_self());
+  size_change(unsettled_size, quantity.amount);
 
+}
 
-ACTION pool::payout (asset quantity, uint64_t start, uint64_t chunksize, int64_t old_total_balance) {
+ACTION pool::settle (uint64_t start, uint64_t chunksize) {
 
   require_auth(get_self());
 
   auto bitr = start == 0 ? balances.begin() : balances.lower_bound(start);
   uint64_t current = 0;
+  int64_t settled = 0;
 
-  int64_t total_balance = old_total_balance == 0 ? int64_t(get_size(total_balance_size)) : old_total_balance;
+  while (bitr != balances.end() && current < chunksize) {
+    name account = bitr->account;
+    bitr++;
+    settled += settle_balance(account);
+    current++;
+  }
 
-  if (total_balance <= 0) { return; }
-  if (quantity.amount <= 0) { return; }
-  if (total_balance < quantity.amount) { return; }
+  // sizes are written once per chunk
+  if (settled > 0) {
+    size_change(total_balance_size, -1 * settled);
+    size_change(unsettled_size, -1 * settled);
+  }
 
-  double total_balance_divisor = double(total_balance);
-  string memo("dSeeds pool distribution");
+  if (bitr != balances.end()) {
+    send_settle(bitr->account.value, chunksize);
+  }
 
-  while (bitr != balances.end() && current < chunksize) {
+}
 
-    double percentage = bitr->balance.amount / total_balance_divisor;
-    asset amount_to_payout = asset(std::min(bitr->balance.amount, int64_t(percentage * quantity.amount)), utils::seeds_symbol);
-    
-    name account = bitr->account;
-    send_transfer(account, amount_to_payout, memo);
-    size_change(total_balance_size, -1 * amount_to_payout.amount);
+ACTION pool::claim (name account) {
 
-    bool emptied = sub_balance( account, amount_to_payout );
-    if( emptied ) {
-      bitr = balances.erase(bitr);
-    } else {
-      bitr++;
+  require_auth(account);
+  check(balances.find(account.value) != balances.end(), "pool: no balance for " + account.to_string());
+
+  settle_account(account);
+
+}
+
+void pool::settle_account (const name & account) {
+
+  int64_t amount = settle_balance(account);
+
+  if (amount > 0) {
+    size_change(total_balance_size, -1 * amount);
+    size_change(unsettled_size, -1 * amount);
+  }
+
+}
+
+// pays the account what it is owed since it was last settled and returns the amount,
+// the caller takes it out of total.sz and unsettled.sz
+int64_t pool::settle_balance (const name & account) {
+
+  auto bitr = balances.find(account.value);
+  if (bitr == balances.end()) { return 0; }
+
+  auto state = payoutstate.get_or_default();
+  uint64_t epoch = bitr->payout_epoch.value_or(0);
+  double index = bitr->payout_index.value_or(0);
+
+  if (epoch == state.epoch && index == state.index) { return 0; }
+
+  int64_t amount = bitr->balance.amount;
+  if (epoch == state.epoch) {
+    double share = 1.0 - std::exp(index - state.index);
+    amount = std::min(amount, int64_t(share * bitr->balance.amount + 0.000001));
+  }
+
+  if (amount > 0) {
+    send_transfer(account, asset(amount, utils::seeds_symbol), "dSeeds pool distribution");
+  }
+
+  if (amount == bitr->balance.amount) {
+    accounts acct(get_self(), account.value);
+    auto aitr = acct.begin();
+    while (aitr != acct.end()) {
+      aitr = acct.erase(aitr);
     }
-    current += 8;
+    balances.erase(bitr);
+    return amount;
   }
 
-  if (bitr != balances.end()) {
-    action next_execution(
-      permission_level(get_self(), "active"_n),
-      get_self(),
-      "payout"_n,
-      std::make_tuple(asset(quantity.amount, utils::seeds_symbol), bitr->account.value, chunksize, total_balance)
-    );
-
-    transaction tx;
-    tx.actions.emplace_back(next_execution);
-    tx.delay_sec = 1;
-    tx.send(bitr->account.value, _self);
+  balances.modify(bitr, _self, [&](auto & item){
+    item.balance.amount -= amount;
+    item.payout_index = state.index;
+    item.payout_epoch = state.epoch;
+  });
+
+  if (amount > 0) {
+    update_pool_token(account, bitr->balance);
   }
+
+  return amount;
+
+}
+
+void pool::send_settle (uint64_t start, uint64_t chunksize) {
+
+  action next_execution(
+    permission_level(get_self(), "active"_n),
+    get_self(),
+    "settle"_n,
+    std::make_tuple(start, chunksize)
+  );
+
+  // replaces a pending chunk, so only one pass runs at a time
+  transaction tx;
+  tx.actions.emplace_back(next_execution);
+  tx.delay_sec = 1;
+  tx.send("settle"_n.value, _self, true);
+
 }
 
 void pool::send_transfer (const name & to, const asset & quantity, const string & memo) {
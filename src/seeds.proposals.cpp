@@ -848,62 +848,19 @@ void proposals::decayvoices() {
       && (now - c.t_onperiod >= decay_time)
       && (now - c.t_voicedecay >= decay_sec)
   ) {
-    c.t_voicedecay = now;
-    cycle.set(c, get_self());
-    uint64_t batch_size = config_get(name("batchsize"));
-    decayvoice(0, batch_size);
-  }
-}
+    uint64_t percentage_decay = config_get(name("vdecayprntge"));
+    check(percentage_decay <= 100, "Voice decay parameter can not be more than 100%.");
 
-void proposals::decayvoice(uint64_t start, uint64_t chunksize) {
-  require_auth(get_self());
-
-  voice_tables voice_alliance(get_self(), alliance_type.value);
-  voice_tables voice_milestone(get_self(), milestone_type.value);
-
-  uint64_t percentage_decay = config_get(name("vdecayprntge"));
-  check(percentage_decay <= 100, "Voice decay parameter can not be more than 100%.");
-  auto vitr = start == 0 ? voice.begin() : voice.find(start);
-  uint64_t count = 0;
-
-  double multiplier = (100.0 - (double)percentage_decay) / 100.0;
-
-  while (vitr != voice.end() && count < chunksize) {
-    auto vaitr = voice_alliance.find(vitr->account.value);
-    auto hvitr = voice_milestone.find(vitr->account.value);
-
-    voice.modify(vitr, _self, [&](auto & v){
-      v.balance *= multiplier;
-    });
-
-    if (vaitr != voice_alliance.end()) {
-      voice_alliance.modify(vaitr, _self, [&](auto & va){
-        va.balance *= multiplier;
-      });
-    }
-
-    if (hvitr != voice_milestone.end()) {
-      voice_milestone.modify(hvitr, _self, [&](auto & hv){
-        hv.balance *= multiplier;
-      });
+    // voice rows are only brought up to date when they are next read or written (voice_balance)
+    if (percentage_decay == 100) {
+      c.decay_epoch = c.decay_epoch.value_or(0) + 1;
+      c.decay_index = 0.0;
+    } else {
+      c.decay_index = c.decay_index.value_or(0) - std::log((100.0 - (double)percentage_decay) / 100.0);
     }
-    vitr++;
-    count++;
-  }
-
-  if (vitr != voice.end()) {
-    uint64_t next_value = vitr->account.value;
-    action next_execution(
-        permission_level{get_self(), "active"_n},
-        get_self(),
-        "decayvoice"_n,
-        std::make_tuple(next_value, chunksize)
-    );
 
-    transaction tx;
-    tx.actions.emplace_back(next_execution);
-    tx.delay_sec = 1;
-    tx.send(next_value, _self);
+    c.t_voicedecay = now;
+    cycle.set(c, get_self());
   }
 }
 
@@ -1347,21 +1304,26 @@ void proposals::erasepartpts(uint64_t active_proposals) {
   uint64_t reward_points = config_get(name("voterep1.ind"));
 
   uint64_t counter = 0;
+  std::vector<std::pair<name, int64_t>> reps;
   auto pitr = participants.begin();
   while (pitr != participants.end() && counter < batch_size) {
     if (pitr -> count == active_proposals && pitr -> nonneutral) {
       if (reward_points > 0) {
-        action(
-          permission_level{contracts::accounts, "active"_n},
-          contracts::accounts, "addrep"_n,
-          std::make_tuple(pitr -> account, reward_points)
-        ).send();
+        reps.push_back(std::make_pair(pitr -> account, int64_t(reward_points)));
       }
     }
     counter += 1;
     pitr = participants.erase(pitr);
   }
 
+  if (!reps.empty()) {
+    action(
+      permission_level{contracts::accounts, "active"_n},
+      contracts::accounts, "addreps"_n,
+      std::make_tuple(reps)
+    ).send();
+  }
+
   if (counter == batch_size) {
     transaction trx_erase_participants{};
     trx_erase_participants.actions.emplace_back(
@@ -1605,6 +1567,32 @@ void proposals::questvote (name user, uint64_t amount, bool reduce, name scope)
   voice_change(user, amount, reduce, scope);
 }
 
+// referendum voice does not decay
+uint64_t proposals::voice_balance (const voice_table & v, name scope) {
+  if (scope == referendum_type) {
+    return v.balance;
+  }
+
+  cycle_table c = cycle.get_or_default(cycle_table());
+
+  if (v.decay_epoch.value_or(0) != c.decay_epoch.value_or(0)) {
+    return 0;
+  }
+
+  double decayed = v.balance * std::exp(v.decay_index.value_or(0) - c.decay_index.value_or(0));
+  return uint64_t(decayed + 0.000001);
+}
+
+void proposals::stamp_voice (voice_table & v, name scope) {
+  if (scope == referendum_type) {
+    return;
+  }
+
+  cycle_table c = cycle.get_or_default(cycle_table());
+  v.decay_index = c.decay_index.value_or(0);
+  v.decay_epoch = c.decay_epoch.value_or(0);
+}
+
 double proposals::voice_change (name user, uint64_t amount, bool reduce, name scope) {
   double percentage_used = 0.0;
 
@@ -1621,21 +1609,25 @@ double proposals::voice_change (name user, uint64_t amount, bool reduce, name sc
         voice_t.emplace(_self, [&](auto & voice){
           voice.account = user;
           voice.balance = amount;
+          stamp_voice(voice, s);
         });
       }
       else {
+        uint64_t balance = voice_balance(*vitr, s);
+
         if (reduce) {
-          check(amount <= vitr->balance, s.to_string() + " voice balance exceeded");
+          check(amount <= balance, s.to_string() + " voice balance exceeded");
         }
 
         increase_size = false;
 
         voice_t.modify(vitr, _self, [&](auto & voice){
           if (reduce) {
-            voice.balance -= amount;
+            voice.balance = balance - amount;
           } else {
-            voice.balance += amount;
+            voice.balance = balance + amount;
           }
+          stamp_voice(voice, s);
         });
       }
     }
@@ -1649,16 +1641,19 @@ double proposals::voice_change (name user, uint64_t amount, bool reduce, name sc
     auto vitr = voice_t.find(user.value);
     check(vitr != voice_t.end(), "user does not have voice");
 
+    uint64_t balance = voice_balance(*vitr, scope);
+
     if (reduce) {
-      check(amount <= vitr->balance, "voice balance exceeded");
-      percentage_used = amount / double(vitr -> balance);
+      check(amount <= balance, "voice balance exceeded");
+      percentage_used = amount / double(balance);
     }
     voice_t.modify(vitr, _self, [&](auto & voice){
       if (reduce) {
-        voice.balance -= amount;
+        voice.balance = balance - amount;
       } else {
-        voice.balance += amount;
+        voice.balance = balance + amount;
       }
+      stamp_voice(voice, scope);
     });
   }
   return percentage_used;
@@ -1677,12 +1672,14 @@ void proposals::set_voice (name user, uint64_t amount, name scope) {
         voice_t.emplace(_self, [&](auto & voice){
           voice.account = user;
           voice.balance = amount;
+          stamp_voice(voice, s);
         });
       }
       else {
         increase_size = false;
         voice_t.modify(vitr, _self, [&](auto & voice){
           voice.balance = amount;
+          stamp_voice(voice, s);
         });
       }
     }
@@ -1698,6 +1695,7 @@ void proposals::set_voice (name user, uint64_t amount, name scope) {
 
     voices.modify(vitr, _self, [&](auto & voice){
       voice.balance = amount;
+      stamp_voice(voice, scope);
     });
   }
 }
@@ -2095,9 +2093,9 @@ ACTION proposals::mimicvote (name delegatee, name delegator, name scope, uint64_
     auto vitr = voices.find(voter.value);
     if (vitr != voices.end()) {
       if (option == trust) {
-        send_vote_on_behalf(voter, proposal_id, vitr -> balance * percentage_used, trust);
+        send_vote_on_behalf(voter, proposal_id, voice_balance(*vitr, scope) * percentage_used, trust);
       } else if (option == distrust) {
-        send_vote_on_behalf(voter, proposal_id, vitr -> balance * percentage_used, distrust);
+        send_vote_on_behalf(voter, proposal_id, voice_balance(*vitr, scope) * percentage_used, distrust);
       } else if (option == abstain) {
         send_vote_on_behalf(voter, proposal_id, uint64_t(0), abstain);
       }
@@ -2,6 +2,8 @@
 
 #include "document_graph/content.cpp"
 #include "document_graph/document.cpp"
+#include "document_graph/variable_document.cpp"
+#include "document_graph/edge_cache.cpp"
 #include "document_graph/edge.cpp"
 #include "document_graph/util.cpp"
 #include "document_graph/content_wrapper.cpp"
@@ -23,6 +25,13 @@ ACTION quests::reset () {
   while (eitr != e_t.end()) {
     eitr = e_t.erase(eitr);
   }
+  hypha::EdgeCache::clear();
+
+  hypha::LegacyEdge::edge_table legacy_e_t(_self, _self.value);
+  auto leitr = legacy_e_t.begin();
+  while (leitr != legacy_e_t.end()) {
+    leitr = legacy_e_t.erase(leitr);
+  }
 
   // create the root node
   hypha::ContentGroups root_cgs {
@@ -60,7 +69,7 @@ ACTION quests::reset () {
 
   hypha::Document root_doc(get_self(), get_self(), std::move(root_cgs));
   hypha::Document account_infos_doc(get_self(), get_self(), std::move(account_infos_cgs));
-  hypha::Document account_infos_v_doc(get_self(), get_self(), std::move(account_infos_v_cgs));
+  hypha::VariableDocument account_infos_v_doc(get_self(), get_self(), std::move(account_infos_v_cgs));
   hypha::Document proposals_doc(get_self(), get_self(), std::move(proposals_cgs));
 
   hypha::Edge::write(get_self(), get_self(), root_doc.getHash(), account_infos_doc.getHash(), graph::OWNS_ACCOUNT_INFOS);
@@ -74,6 +83,84 @@ ACTION quests::reset () {
 
 }
 
+// moves the edges table to the collision free indexes in chunks
+ACTION quests::migrateedges (uint64_t chunksize) {
+
+  require_auth(get_self());
+
+  if (m_documentGraph.migrateEdges(chunksize)) {
+    return;
+  }
+
+  action next_execution(
+    permission_level(get_self(), "active"_n),
+    get_self(),
+    "migrateedges"_n,
+    std::make_tuple(chunksize)
+  );
+
+  transaction tx;
+  tx.actions.emplace_back(next_execution);
+  tx.delay_sec = 1;
+  tx.send("migrateedges"_n.value, _self);
+
+}
+
+// writes an edge to the old edges table, its index values are not read by migrateedges
+ACTION quests::testlgcyedge (checksum256 from_node, checksum256 to_node, name edge_name) {
+
+  require_auth(get_self());
+
+  hypha::LegacyEdge::edge_table legacy_e_t(_self, _self.value);
+
+  legacy_e_t.emplace(_self, [&](auto & e){
+    e.id = legacy_e_t.available_primary_key();
+    e.from_node_edge_name_index = 0;
+    e.from_node_to_node_index = 0;
+    e.to_node_edge_name_index = 0;
+    e.from_node = from_node;
+    e.to_node = to_node;
+    e.edge_name = edge_name;
+    e.created_date = eosio::current_time_point();
+    e.creator = get_self();
+    e.contract = get_self();
+  });
+
+}
+
+#ifdef SEEDS_BENCHMARK
+// builds a document of num_contents mixed contents (groups of 10) and prints its hash - see scripts/benchmark.document.js
+ACTION quests::testhashdoc (uint64_t num_contents) {
+
+  require_auth(get_self());
+
+  hypha::ContentGroups content_groups;
+
+  for (uint64_t i = 0; i < num_contents; i++) {
+    if (i % 10 == 0) {
+      content_groups.push_back(hypha::ContentGroup{});
+    }
+
+    string label = "c" + std::to_string(i);
+    hypha::Content::FlexValue value;
+
+    switch (i % 6) {
+      case 0: value = int64_t(i * 1000); break;
+      case 1: value = asset(i, utils::seeds_symbol); break;
+      case 2: value = eosio::time_point(eosio::seconds(1600000000 + i)); break;
+      case 3: value = "value " + std::to_string(i); break;
+      case 4: value = eosio::sha256(label.c_str(), label.size()); break;
+      default: value = name("seeds"); break;
+    }
+
+    content_groups.back().push_back(hypha::Content(label, value));
+  }
+
+  print(hypha::readableHash(hypha::Document::hashContents(content_groups)));
+
+}
+#endif
+
 ACTION quests::stake (name from, name to, asset quantity, string memo) {
 
   if (get_first_receiver() == contracts::token  &&  // from SEEDS token account
@@ -82,7 +169,7 @@ ACTION quests::stake (name from, name to, asset quantity, string memo) {
     utils::check_asset(quantity);
 
     hypha::Document account_info_doc = get_account_info(from, true);
-    hypha::Document account_info_v_doc = get_variable_node_or_fail(account_info_doc);
+    hypha::VariableDocument account_info_v_doc = get_variable_node_or_fail(account_info_doc);
 
     if (from == bankaccts::campaigns) {
       hypha::ContentWrapper account_info_v_cw = account_info_v_doc.getContentWrapper();
@@ -96,7 +183,7 @@ ACTION quests::stake (name from, name to, asset quantity, string memo) {
     }
 
     hypha::Document account_infos_doc = get_account_infos_node();
-    hypha::Document account_infos_v_doc = get_variable_node_or_fail(account_infos_doc);
+    hypha::VariableDocument account_infos_v_doc = get_variable_node_or_fail(account_infos_doc);
     add_balance(account_infos_v_doc, quantity);
 
   }
@@ -109,14 +196,14 @@ ACTION quests::withdraw (name beneficiary, asset quantity) {
   utils::check_asset(quantity);
 
   hypha::Document account_info_doc = get_account_info(beneficiary, false);
-  hypha::Document account_info_v_doc = get_variable_node_or_fail(account_info_doc);
+  hypha::VariableDocument account_info_v_doc = get_variable_node_or_fail(account_info_doc);
   sub_balance(account_info_v_doc, quantity);
 
   token::transfer_action action{contracts::token, {get_self(), "active"_n}};
   action.send(get_self(), beneficiary, quantity, "");
 
   hypha::Document balances_doc = get_account_infos_node();
-  hypha::Document balances_v_doc = get_variable_node_or_fail(balances_doc);
+  hypha::VariableDocument balances_v_doc = get_variable_node_or_fail(balances_doc);
   sub_balance(balances_v_doc, quantity);
 
 }
@@ -167,7 +254,7 @@ ACTION quests::addquest (name creator, asset amount, string title, string descri
     }
   };
 
-  hypha::Document quest_v_doc(get_self(), creator, std::move(quest_v_cgs));
+  hypha::VariableDocument quest_v_doc(get_self(), creator, std::move(quest_v_cgs));
 
   hypha::Document root_doc = get_root_node();
   hypha::Document account_info_doc = get_account_info(creator, true);
@@ -189,7 +276,7 @@ ACTION quests::addmilestone (checksum256 quest_hash, string title, string descri
   check_user(creator);
   check_quest_status_stage(quest_hash, ""_n, quest_stage_staged, "quests: can not add milestone when quest is not staged");
 
-  hypha::Document quest_v_doc = get_variable_node_or_fail(quest_doc);
+  hypha::VariableDocument quest_v_doc = get_variable_node_or_fail(quest_doc);
   hypha::ContentWrapper quest_v_cw = quest_v_doc.getContentWrapper();
   int64_t unfinished_milestones = quest_v_cw.getOrFail(VARIABLE_DETAILS, UNFINISHED_MILESTONES) -> getAs<int64_t>();
 
@@ -236,7 +323,7 @@ ACTION quests::addmilestone (checksum256 quest_hash, string title, string descri
     }
   };
 
-  hypha::Document milestone_v_doc(get_self(), creator, std::move(milestone_v_cgs));
+  hypha::VariableDocument milestone_v_doc(get_self(), creator, std::move(milestone_v_cgs));
 
   hypha::Edge::write(get_self(), creator, milestone_doc.getHash(), milestone_v_doc.getHash(), graph::VARIABLE);
   hypha::Edge::write(get_self(), creator, quest_hash, milestone_doc.getHash(), graph::HAS_MILESTONE);
@@ -247,7 +334,7 @@ ACTION quests::addmilestone (checksum256 quest_hash, string title, string descri
 ACTION quests::delmilestone (checksum256 milestone_hash) {
 
   hypha::Document milestone_doc(get_self(), milestone_hash);
-  hypha::Document milestone_v_doc = get_variable_node_or_fail(milestone_doc);
+  hypha::VariableDocument milestone_v_doc = get_variable_node_or_fail(milestone_doc);
   hypha::ContentWrapper milestone_cw = milestone_doc.getContentWrapper();
 
   check_type(milestone_doc, graph::MILESTONE);
@@ -259,7 +346,7 @@ ACTION quests::delmilestone (checksum256 milestone_hash) {
   require_auth(creator);
   check_quest_status_stage(quest_hash, ""_n, quest_stage_staged, "quests: can not delete milestone");
 
-  hypha::Document quest_v_doc = get_variable_node_or_fail(quest_doc);
+  hypha::VariableDocument quest_v_doc = get_variable_node_or_fail(quest_doc);
   hypha::ContentWrapper quest_v_cw = quest_v_doc.getContentWrapper();
   int64_t unfinished_milestones = quest_v_cw.getOrFail(VARIABLE_DETAILS, UNFINISHED_MILESTONES) -> getAs<int64_t>();
 
@@ -276,7 +363,7 @@ ACTION quests::delmilestone (checksum256 milestone_hash) {
 ACTION quests::activate (checksum256 quest_hash) {
 
   hypha::Document quest_doc(get_self(), quest_hash);
-  hypha::Document quest_v_doc = get_variable_node_or_fail(quest_doc);
+  hypha::VariableDocument quest_v_doc = get_variable_node_or_fail(quest_doc);
 
   name creator = quest_doc.getCreator();
 
@@ -305,7 +392,7 @@ ACTION quests::activate (checksum256 quest_hash) {
   }
 
   hypha::Document account_creator_doc = get_account_info(creator, false);
-  hypha::Document account_creator_v_doc = get_variable_node_or_fail(account_creator_doc);
+  hypha::VariableDocument account_creator_v_doc = get_variable_node_or_fail(account_creator_doc);
   hypha::ContentWrapper account_creator_v_cw = account_creator_v_doc.getContentWrapper();
 
   asset staked_amount = account_creator_v_cw.getOrFail(VARIABLE_DETAILS, ACCOUNT_BALANCE) -> getAs<asset>();
@@ -332,7 +419,7 @@ ACTION quests::propactivate (checksum256 quest_hash) {
   require_auth(get_self());
 
   hypha::Document quest_doc(get_self(), quest_hash);
-  hypha::Document quest_v_doc = get_variable_node_or_fail(quest_doc);
+  hypha::VariableDocument quest_v_doc = get_variable_node_or_fail(quest_doc);
 
   update_node(&quest_v_doc, VARIABLE_DETAILS, {
     hypha::Content(STAGE, quest_stage_active)
@@ -346,7 +433,7 @@ ACTION quests::propactivate (checksum256 quest_hash) {
 ACTION quests::notactivate (checksum256 quest_hash) {
 
   hypha::Document quest_doc(get_self(), quest_hash);
-  hypha::Document quest_v_doc = get_variable_node_or_fail(quest_doc);
+  hypha::VariableDocument quest_v_doc = get_variable_node_or_fail(quest_doc);
 
   require_auth(get_self());
 
@@ -368,7 +455,7 @@ ACTION quests::notactivate (checksum256 quest_hash) {
 ACTION quests::delquest (checksum256 quest_hash) {
 
   hypha::Document quest_doc(get_self(), quest_hash);
-  hypha::Document quest_v_doc = get_variable_node_or_fail(quest_doc);
+  hypha::VariableDocument quest_v_doc = get_variable_node_or_fail(quest_doc);
 
   name creator = quest_doc.getCreator();
 
@@ -422,7 +509,7 @@ ACTION quests::apply (checksum256 quest_hash, name applicant, string description
     }
   };
 
-  hypha::Document applicant_v_doc(get_self(), applicant, std::move(applicant_v_cgs));
+  hypha::VariableDocument applicant_v_doc(get_self(), applicant, std::move(applicant_v_cgs));
 
   hypha::Edge::write(get_self(), applicant, quest_hash, applicant_doc.getHash(), graph::HAS_APPLICANT);
   hypha::Edge::write(get_self(), applicant, applicant_doc.getHash(), applicant_v_doc.getHash(), graph::VARIABLE);
@@ -437,7 +524,7 @@ ACTION quests::apply (checksum256 quest_hash, name applicant, string description
 ACTION quests::accptapplcnt (checksum256 applicant_hash) {
 
   hypha::Document applicant_doc(get_self(), applicant_hash);
-  hypha::Document applicant_v_doc = get_variable_node_or_fail(applicant_doc);
+  hypha::VariableDocument applicant_v_doc = get_variable_node_or_fail(applicant_doc);
   hypha::ContentWrapper applicant_cw = applicant_doc.getContentWrapper();
 
   check_type(applicant_doc, graph::APPLICANT);
@@ -459,7 +546,7 @@ ACTION quests::accptapplcnt (checksum256 applicant_hash) {
     check(!exists, "quests: quest already has an accepted applicant");
   } else {
     if (exists) { print("ACCPTAPPLICNT not executed\n"); return; }
-    hypha::Document quest_v_doc = get_variable_node_or_fail(quest_doc);
+    hypha::VariableDocument quest_v_doc = get_variable_node_or_fail(quest_doc);
     hypha::ContentWrapper quest_v_cw = quest_v_doc.getContentWrapper();
     name stage = quest_v_cw.getOrFail(VARIABLE_DETAILS, STAGE) -> getAs<name>();
     if (stage != quest_stage_active) { return; }
@@ -481,7 +568,7 @@ ACTION quests::accptapplcnt (checksum256 applicant_hash) {
 ACTION quests::rejctapplcnt (checksum256 applicant_hash) {
 
   hypha::Document applicant_doc(get_self(), applicant_hash);
-  hypha::Document applicant_v_doc = get_variable_node_or_fail(applicant_doc);
+  hypha::VariableDocument applicant_v_doc = get_variable_node_or_fail(applicant_doc);
   hypha::ContentWrapper applicant_cw = applicant_doc.getContentWrapper();
 
   check_type(applicant_doc, graph::APPLICANT);
@@ -511,7 +598,7 @@ ACTION quests::accptquest (checksum256 quest_hash) {
   check_type(quest_doc, graph::QUEST);
 
   hypha::Document maker_doc = get_doc_from_edge(quest_hash, graph::HAS_ACCPTAPPL);
-  hypha::Document maker_v_doc = get_variable_node_or_fail(maker_doc);
+  hypha::VariableDocument maker_v_doc = get_variable_node_or_fail(maker_doc);
   hypha::ContentWrapper maker_cw = maker_doc.getContentWrapper();
   hypha::ContentWrapper maker_v_cw = maker_v_doc.getContentWrapper();
 
@@ -523,7 +610,7 @@ ACTION quests::accptquest (checksum256 quest_hash) {
     hypha::Content(STATUS, applicant_status_confirmed)
   });
 
-  hypha::Document quest_v_doc = get_variable_node_or_fail(quest_doc);
+  hypha::VariableDocument quest_v_doc = get_variable_node_or_fail(quest_doc);
   update_node(&quest_v_doc, VARIABLE_DETAILS, {
     hypha::Content(STARTED_DATE, int64_t(eosio::current_time_point().sec_since_epoch()))
   });
@@ -539,7 +626,7 @@ ACTION quests::accptquest (checksum256 quest_hash) {
 ACTION quests::mcomplete (checksum256 milestone_hash, string url_documentation, string description) {
 
   hypha::Document milestone_doc(get_self(), milestone_hash);
-  hypha::Document milestone_v_doc = get_variable_node_or_fail(milestone_doc);
+  hypha::VariableDocument milestone_v_doc = get_variable_node_or_fail(milestone_doc);
 
   check_type(milestone_doc, graph::MILESTONE);
 
@@ -569,7 +656,7 @@ ACTION quests::mcomplete (checksum256 milestone_hash, string url_documentation,
 
 }
 
-void quests::accept_milestone (hypha::Document & milestone_doc, hypha::Document & milestone_v_doc) {
+void quests::accept_milestone (hypha::Document & milestone_doc, hypha::VariableDocument & milestone_v_doc) {
 
   hypha::ContentWrapper milestone_cw = milestone_doc.getContentWrapper();
   asset payout_amount = milestone_cw.getOrFail(FIXED_DETAILS, PAYOUT_AMOUNT) -> getAs<asset>();
@@ -577,7 +664,7 @@ void quests::accept_milestone (hypha::Document & milestone_doc, hypha::Document
   update_milestone_status(&milestone_v_doc, milestone_status_finished, milestone_status_completed);
 
   hypha::Document quest_doc = get_quest_node_from_milestone(milestone_doc);
-  hypha::Document quest_v_doc = get_variable_node_or_fail(quest_doc);
+  hypha::VariableDocument quest_v_doc = get_variable_node_or_fail(quest_doc);
   hypha::ContentWrapper quest_v_cw = quest_v_doc.getContentWrapper();
 
   int64_t unfinished_milestones = quest_v_cw.getOrFail(VARIABLE_DETAILS, UNFINISHED_MILESTONES) -> getAs<int64_t>();
@@ -605,7 +692,7 @@ void quests::accept_milestone (hypha::Document & milestone_doc, hypha::Document
 ACTION quests::accptmilstne (checksum256 milestone_hash) {
 
   hypha::Document milestone_doc(get_self(), milestone_hash);
-  hypha::Document milestone_v_doc = get_variable_node_or_fail(milestone_doc);
+  hypha::VariableDocument milestone_v_doc = get_variable_node_or_fail(milestone_doc);
 
   check_type(milestone_doc, graph::MILESTONE);
 
@@ -629,7 +716,7 @@ ACTION quests::propaccptmil (checksum256 milestone_hash) {
   require_auth(get_self());
 
   hypha::Document milestone_doc(get_self(), milestone_hash);
-  hypha::Document milestone_v_doc = get_variable_node_or_fail(milestone_doc);
+  hypha::VariableDocument milestone_v_doc = get_variable_node_or_fail(milestone_doc);
 
   accept_milestone(milestone_doc, milestone_v_doc);
 
@@ -641,7 +728,7 @@ ACTION quests::propaccptmil (checksum256 milestone_hash) {
 ACTION quests::payoutmilstn (checksum256 milestone_hash) {
 
   hypha::Document milestone_doc(get_self(), milestone_hash);
-  hypha::Document milestone_v_doc = get_variable_node_or_fail(milestone_doc);
+  hypha::VariableDocument milestone_v_doc = get_variable_node_or_fail(milestone_doc);
   hypha::Document quest_doc = get_quest_node_from_milestone(milestone_doc);
   hypha::Document maker_doc = get_doc_from_edge(quest_doc.getHash(), graph::HAS_MAKER);
 
@@ -659,7 +746,7 @@ ACTION quests::payoutmilstn (checksum256 milestone_hash) {
   name fund = quest_cw.getOrFail(FIXED_DETAILS, FUND) -> getAs<name>();
 
   hypha::Document account_info_doc = get_account_info(fund, false);
-  hypha::Document account_info_v_doc = get_variable_node_or_fail(account_info_doc);
+  hypha::VariableDocument account_info_v_doc = get_variable_node_or_fail(account_info_doc);
   hypha::ContentWrapper account_info_v_cw = account_info_v_doc.getContentWrapper();
 
   asset locked_balance = account_info_v_cw.getOrFail(VARIABLE_DETAILS, LOCKED_BALANCE) -> getAs<asset>();
@@ -681,7 +768,7 @@ ACTION quests::payoutmilstn (checksum256 milestone_hash) {
 ACTION quests::rejctmilstne (checksum256 milestone_hash) {
 
   hypha::Document milestone_doc(get_self(), milestone_hash);
-  hypha::Document milestone_v_doc = get_variable_node_or_fail(milestone_doc);
+  hypha::VariableDocument milestone_v_doc = get_variable_node_or_fail(milestone_doc);
 
   check_type(milestone_doc, graph::MILESTONE);
 
@@ -748,7 +835,7 @@ void quests::propose_aux (const checksum256 & node_hash, const name & quest_owne
     }
   };
 
-  hypha::Document proposal_v_doc(get_self(), get_self(), std::move(proposal_v_cgs));
+  hypha::VariableDocument proposal_v_doc(get_self(), get_self(), std::move(proposal_v_cgs));
 
   hypha::Edge::write(get_self(), get_self(), proposal_doc.getHash(), node_doc.getHash(), graph::PROPOSE);
   hypha::Edge::write(get_self(), get_self(), node_doc.getHash(), proposal_doc.getHash(), graph::PROPOSED_BY);
@@ -779,7 +866,7 @@ ACTION quests::evalprop (checksum256 proposal_hash) {
   hypha::Document proposal_doc(get_self(), proposal_hash);
   hypha::ContentWrapper proposal_cw = proposal_doc.getContentWrapper();
 
-  hypha::Document proposal_v_doc = get_variable_node_or_fail(proposal_doc);
+  hypha::VariableDocument proposal_v_doc = get_variable_node_or_fail(proposal_doc);
   hypha::ContentWrapper proposal_v_cw = proposal_v_doc.getContentWrapper();
 
   if(has_auth(get_self())) {
@@ -888,7 +975,7 @@ bool quests::is_active(hypha::ContentWrapper & account_info_v_cw, int64_t & cuto
 void quests::vote_aux (name & voter, const checksum256 & proposal_hash, int64_t & amount, const name & option) {
 
   hypha::Document proposal_doc(get_self(), proposal_hash);
-  hypha::Document proposal_v_doc = get_variable_node_or_fail(proposal_doc);
+  hypha::VariableDocument proposal_v_doc = get_variable_node_or_fail(proposal_doc);
   hypha::ContentWrapper proposal_cw = proposal_doc.getContentWrapper(); 
   hypha::ContentWrapper proposal_v_cw = proposal_v_doc.getContentWrapper();
 
@@ -977,7 +1064,7 @@ ACTION quests::against (name voter, checksum256 proposal_hash, int64_t amount) {
 ACTION quests::expirequest (checksum256 quest_hash) {
 
   hypha::Document quest_doc(get_self(), quest_hash);
-  hypha::Document quest_v_doc = get_variable_node_or_fail(quest_doc);
+  hypha::VariableDocument quest_v_doc = get_variable_node_or_fail(quest_doc);
   hypha::ContentWrapper quest_cw = quest_doc.getContentWrapper();
   hypha::ContentWrapper quest_v_cw = quest_v_doc.getContentWrapper();
 
@@ -1003,7 +1090,7 @@ ACTION quests::expirequest (checksum256 quest_hash) {
   }
 
   hypha::Document fund_doc = get_account_info(fund, false);
-  hypha::Document fund_v_doc = get_variable_node_or_fail(fund_doc);
+  hypha::VariableDocument fund_v_doc = get_variable_node_or_fail(fund_doc);
   hypha::ContentWrapper fund_v_cw = fund_v_doc.getContentWrapper();
 
   asset locked_balance = fund_v_cw.getOrFail(VARIABLE_DETAILS, LOCKED_BALANCE) -> getAs<asset>();
@@ -1014,7 +1101,7 @@ ACTION quests::expirequest (checksum256 quest_hash) {
     action.send(get_self(), bankaccts::campaigns, refund_amount, "quest refund");
 
     hypha::Document balances_doc = get_account_infos_node();
-    hypha::Document balances_v_doc = get_variable_node_or_fail(balances_doc);
+    hypha::VariableDocument balances_v_doc = get_variable_node_or_fail(balances_doc);
     sub_balance(balances_v_doc, refund_amount);
 
     update_node(&fund_v_doc, VARIABLE_DETAILS, {
@@ -1043,7 +1130,7 @@ ACTION quests::expireappl (checksum256 maker_hash) {
 
   check_type(maker_doc, graph::APPLICANT);
 
-  hypha::Document maker_v_doc = get_variable_node_or_fail(maker_doc);
+  hypha::VariableDocument maker_v_doc = get_variable_node_or_fail(maker_doc);
   hypha::ContentWrapper maker_v_cw = maker_v_doc.getContentWrapper();
 
   name status = maker_v_cw.getOrFail(VARIABLE_DETAILS, STATUS) -> getAs<name>();
@@ -1087,7 +1174,7 @@ ACTION quests::cancelappl (checksum256 maker_hash) {
 
   check_type(maker_doc, graph::APPLICANT);
 
-  hypha::Document maker_v_doc = get_variable_node_or_fail(maker_doc);
+  hypha::VariableDocument maker_v_doc = get_variable_node_or_fail(maker_doc);
   hypha::ContentWrapper maker_v_cw = maker_v_doc.getContentWrapper();
 
   name status = maker_v_cw.getOrFail(VARIABLE_DETAILS, STATUS) -> getAs<name>();
@@ -1127,7 +1214,7 @@ ACTION quests::retractappl (checksum256 applicant_hash) {
   name applicant_account = applicant_cw.getOrFail(FIXED_DETAILS, APPLICANT_ACCOUNT) -> getAs<name>();
   require_auth(applicant_account);
 
-  hypha::Document applicant_v_doc = get_variable_node_or_fail(applicant_doc);
+  hypha::VariableDocument applicant_v_doc = get_variable_node_or_fail(applicant_doc);
   hypha::ContentWrapper applicant_v_cw = applicant_v_doc.getContentWrapper();
 
   name status = applicant_v_cw.getOrFail(VARIABLE_DETAILS, STATUS) -> getAs<name>();
@@ -1144,7 +1231,7 @@ ACTION quests::retractappl (checksum256 applicant_hash) {
   if (creator != fund) {
     hypha::Edge edge = hypha::Edge::get(get_self(), applicant_hash, graph::PROPOSED_BY);
     hypha::Document proposal_doc(get_self(), edge.getToNode());
-    hypha::Document proposal_v_doc = get_variable_node_or_fail(proposal_doc);
+    hypha::VariableDocument proposal_v_doc = get_variable_node_or_fail(proposal_doc);
     hypha::ContentWrapper proposal_v_cw = proposal_v_doc.getContentWrapper();
 
     name proposal_stage = proposal_v_cw.getOrFail(VARIABLE_DETAILS, STAGE) -> getAs<name>();
@@ -1176,7 +1263,7 @@ ACTION quests::quitapplcnt (checksum256 applicant_hash) {
   check(p.first, "quests: quest does not have a maker");
   check(p.second.getToNode() == applicant_hash, "quests: applicant is not a maker");
 
-  hypha::Document applicant_v_doc = get_variable_node_or_fail(applicant_doc);
+  hypha::VariableDocument applicant_v_doc = get_variable_node_or_fail(applicant_doc);
 
   update_node(&applicant_v_doc, VARIABLE_DETAILS, {
     hypha::Content(STATUS, applicant_status_quitted)
@@ -1204,7 +1291,7 @@ ACTION quests::rateapplcnt (checksum256 maker_hash, name opinion) {
 
   require_auth(creator);
 
-  hypha::Document maker_v_doc = get_variable_node_or_fail(maker_doc);
+  hypha::VariableDocument maker_v_doc = get_variable_node_or_fail(maker_doc);
   hypha::ContentWrapper maker_v_cw = maker_v_doc.getContentWrapper();
 
   auto [idx, item] = maker_v_cw.get(VARIABLE_DETAILS, OWNER_OPINION);
@@ -1237,7 +1324,7 @@ ACTION quests::ratequest (checksum256 quest_hash, name opinion) {
   require_auth(applicant_account);
   check_quest_status_stage(quest_hash, quest_status_finished, quest_stage_done, "quests: can not rate quest");
 
-  hypha::Document quest_v_doc = get_variable_node_or_fail(quest_doc);
+  hypha::VariableDocument quest_v_doc = get_variable_node_or_fail(quest_doc);
   hypha::ContentWrapper quest_v_cw = quest_v_doc.getContentWrapper();
 
   auto [idx, item] = quest_v_cw.get(VARIABLE_DETAILS, APPLICANT_OPINION);
@@ -1283,9 +1370,7 @@ bool quests::check_auth_create_proposal(name & creator, name & fund) {
   return create_proposal;
 }
 
-void quests::update_node (hypha::Document * node_doc, const string & content_group_label, const std::vector<hypha::Content> & new_contents) {
-
-  checksum256 old_node_hash = node_doc -> getHash();
+void quests::update_node (hypha::VariableDocument * node_doc, const string & content_group_label, const std::vector<hypha::Content> & new_contents) {
 
   hypha::ContentWrapper node_cw = node_doc -> getContentWrapper();
   hypha::ContentGroup * node_cg = node_cw.getGroupOrFail(content_group_label);
@@ -1294,7 +1379,7 @@ void quests::update_node (hypha::Document * node_doc, const string & content_gro
     hypha::ContentWrapper::insertOrReplace(*node_cg, new_contents[i]);
   }
 
-  m_documentGraph.updateDocument(get_self(), old_node_hash, node_doc -> getContentGroups());
+  node_doc -> modify();
 
 }
 
@@ -1344,8 +1429,9 @@ hypha::Document quests::get_proposals_node () {
   return get_doc_from_edge(root_doc.getHash(), graph::OWNS_PROPOSALS);
 }
 
-hypha::Document quests::get_variable_node_or_fail (hypha::Document & fixed_node) {
-  return get_doc_from_edge(fixed_node.getHash(), graph::VARIABLE);
+hypha::VariableDocument quests::get_variable_node_or_fail (hypha::Document & fixed_node) {
+  std::vector<hypha::Edge> edges = m_documentGraph.getEdgesFromOrFail(fixed_node.getHash(), graph::VARIABLE);
+  return hypha::VariableDocument(get_self(), edges[0].getToNode());
 }
 
 void quests::check_auth (name & creator, name & fund) {
@@ -1361,7 +1447,7 @@ void quests::check_quest_status_stage (const checksum256 & quest_hash, const nam
   hypha::Document quest_doc(get_self(), quest_hash);
   std::vector<hypha::Edge> edges = m_documentGraph.getEdgesFromOrFail(quest_hash, graph::VARIABLE);
 
-  hypha::Document quest_v_doc(get_self(), edges[0].getToNode());
+  hypha::VariableDocument quest_v_doc(get_self(), edges[0].getToNode());
   hypha::ContentWrapper cw = quest_v_doc.getContentWrapper();
 
   check_quest_status_stage(cw, status, stage, error_msg);
@@ -1401,9 +1487,8 @@ void quests::validate_milestones (const checksum256 & quest_hash) {
 
 }
 
-void quests::update_balance (hypha::Document & balance_doc, asset & quantity, const bool & substract) {
+void quests::update_balance (hypha::VariableDocument & balance_doc, asset & quantity, const bool & substract) {
 
-    checksum256 oldHash = balance_doc.getHash();
     hypha::ContentWrapper old_cw = balance_doc.getContentWrapper();
 
     asset old_balance_asset = old_cw.getOrFail(VARIABLE_DETAILS, ACCOUNT_BALANCE) -> getAs<asset>();
@@ -1420,16 +1505,16 @@ void quests::update_balance (hypha::Document & balance_doc, asset & quantity, co
     hypha::ContentGroup * cg = old_cw.getGroupOrFail(VARIABLE_DETAILS);
     hypha::ContentWrapper::insertOrReplace(*cg, new_balance);
 
-    m_documentGraph.updateDocument(get_self(), oldHash, balance_doc.getContentGroups());
+    balance_doc.modify();
 
 }
 
-void quests::add_balance (hypha::Document & balance_doc, asset & quantity) {
+void quests::add_balance (hypha::VariableDocument & balance_doc, asset & quantity) {
   utils::check_asset(quantity);
   update_balance(balance_doc, quantity, false);
 }
 
-void quests::sub_balance (hypha::Document & balance_doc, asset & quantity) {
+void quests::sub_balance (hypha::VariableDocument & balance_doc, asset & quantity) {
   utils::check_asset(quantity);
   update_balance(balance_doc, quantity, true);
 }
@@ -1468,7 +1553,7 @@ hypha::Document quests::get_account_info (name & account, const bool & create_if
       };
 
       hypha::Document account_info_doc(get_self(), get_self(), std::move(account_info_cgs));
-      hypha::Document account_info_v_doc(get_self(), get_self(), std::move(account_info_v_cgs));
+      hypha::VariableDocument account_info_v_doc(get_self(), get_self(), std::move(account_info_v_cgs));
 
       hypha::Edge::write(get_self(), get_self(), account_infos_doc.getHash(), account_info_doc.getHash(), account);
       hypha::Edge::write(get_self(), get_self(), account_info_doc.getHash(), account_info_v_doc.getHash(), graph::VARIABLE);
@@ -1499,9 +1584,7 @@ hypha::Document quests::get_quest_node_from_milestone (hypha::Document & milesto
 
 }
 
-void quests::update_milestone_status (hypha::Document * milestone_v_doc, const name & new_status, const name & check_status) {
-  
-  checksum256 old_hash = milestone_v_doc -> getHash();
+void quests::update_milestone_status (hypha::VariableDocument * milestone_v_doc, const name & new_status, const name & check_status) {
   
   hypha::ContentWrapper milestone_v_cw = milestone_v_doc -> getContentWrapper();
 
@@ -1513,7 +1596,7 @@ void quests::update_milestone_status (hypha::Document * milestone_v_doc, const n
   hypha::ContentGroup * cg = milestone_v_cw.getGroupOrFail(VARIABLE_DETAILS);
   hypha::ContentWrapper::insertOrReplace(*cg, hypha::Content(STATUS, new_status));
   
-  m_documentGraph.updateDocument(get_self(), old_hash, milestone_v_doc -> getContentGroups());
+  milestone_v_doc -> modify();
 
 }
 
@@ -1539,7 +1622,7 @@ void quests::send_to_escrow (const name & fromfund, const name & recipient, asse
   .send();
 
   hypha::Document balances_doc = get_account_infos_node();
-  hypha::Document balances_v_doc = get_variable_node_or_fail(balances_doc);
+  hypha::VariableDocument balances_v_doc = get_variable_node_or_fail(balances_doc);
   sub_balance(balances_v_doc, quantity);
 
   print("SEND TO ESCROW\n");
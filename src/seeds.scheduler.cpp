@@ -3,6 +3,8 @@
 #include <eosio/transaction.hpp>
 #include <contracts.hpp>
 #include <string>
+#include <limits>
+#include <algorithm>
 
 
 uint64_t scheduler::is_ready_op (const name & operation, const uint64_t & timestamp) {
@@ -16,7 +18,10 @@ uint64_t scheduler::is_ready_op (const name & operation, const uint64_t & timest
 
     uint64_t periods = 0;
 
-    periods = (timestamp - itr -> timestamp) / itr -> period;
+    // ops configured with a start time in the future are not due yet
+    if (timestamp >= itr -> timestamp) {
+        periods = (timestamp - itr -> timestamp) / itr -> period;
+    }
 
     print("\nPERIODS: " + std::to_string(periods) + ", current_time: " + std::to_string(timestamp) + ", last_timestap: " + std::to_string(itr->timestamp) );
 
@@ -33,17 +38,49 @@ uint64_t scheduler::is_ready_moon_op (const name & operation, const uint64_t & t
         return 0;
     }
 
-    uint64_t moon_timestamp = 0;
+    uint64_t moon_timestamp = moon_op_due_time(mitr->start_time, mitr->last_moon_cycle_id, mitr->quarter_moon_cycles);
 
-    if (mitr->start_time > mitr->last_moon_cycle_id) {
-        moon_timestamp = mitr->start_time;
-    } else {
-        auto mpitr = moonphases.find(mitr->last_moon_cycle_id);
-        std::advance(mpitr, mitr->quarter_moon_cycles);
-        moon_timestamp = mpitr->timestamp;
+    return timestamp >= moon_timestamp ? moon_timestamp : 0;
+
+}
+
+// the moon phase the op runs at next, max uint64 if that phase has not been added yet
+uint64_t scheduler::moon_op_due_time (const uint64_t & start_time, const uint64_t & last_moon_cycle_id, const uint64_t & quarter_moon_cycles) {
+
+    if (start_time > last_moon_cycle_id) {
+        return start_time;
     }
 
-    return timestamp >= moon_timestamp ? moon_timestamp : 0;
+    auto mpitr = moonphases.find(last_moon_cycle_id);
+    uint64_t count = 0;
+
+    while (mpitr != moonphases.end() && count < quarter_moon_cycles) {
+        mpitr++;
+        count++;
+    }
+
+    return mpitr != moonphases.end() ? mpitr->timestamp : std::numeric_limits<uint64_t>::max();
+
+}
+
+// earliest time any unpaused op is due
+uint64_t scheduler::next_due_time () {
+
+    uint64_t next_due = std::numeric_limits<uint64_t>::max();
+
+    auto ops_by_next_due = operations.get_index<"bynextdue"_n>();
+    auto itr = ops_by_next_due.begin();
+    if (itr != ops_by_next_due.end()) {
+        next_due = itr->by_next_due();
+    }
+
+    auto moonops_by_next_due = moonops.get_index<"bynextdue"_n>();
+    auto mitr = moonops_by_next_due.begin();
+    if (mitr != moonops_by_next_due.end()) {
+        next_due = std::min(next_due, mitr->by_next_due());
+    }
+
+    return next_due;
 
 }
 
@@ -132,7 +169,11 @@ void scheduler::reset_aux(bool destructive) {
         name("hstry.ptrxs"),
 
         name("dao.cleanvts"),
-        name("dao.calcdist")
+        name("dao.calcdist"),
+
+        name("hrvst.rankal"), // fused ranking, replaces ranktx, rankpl, calccs and rankcs when unpaused
+        name("hstry.svtrxs"),
+        name("hstry.exptrx")
     };
     
     std::vector<name> operations_v = {
@@ -174,7 +215,11 @@ void scheduler::reset_aux(bool destructive) {
         name("cleanptrxs"),
 
         name("dhocleanvts"),
-        name("dhocalcdists")
+        name("dhocalcdists"),
+
+        name("rankalls"),
+        name("savetrxs"),
+        name("expiretrxs")
     };
 
     std::vector<name> contracts_v = {
@@ -216,7 +261,11 @@ void scheduler::reset_aux(bool destructive) {
         contracts::history,
 
         contracts::dao,
-        contracts::dao
+        contracts::dao,
+
+        contracts::harvest,
+        contracts::history,
+        contracts::history
     };
 
     std::vector<uint64_t> delay_v = {
@@ -258,7 +307,11 @@ void scheduler::reset_aux(bool destructive) {
         utils::seconds_per_day,
 
         utils::seconds_per_day,
-        utils::seconds_per_hour
+        utils::seconds_per_hour,
+
+        utils::seconds_per_hour,
+        utils::seconds_per_minute * 5,
+        utils::seconds_per_day
     };
 
     uint64_t now = current_time_point().sec_since_epoch();
@@ -302,6 +355,10 @@ void scheduler::reset_aux(bool destructive) {
         now,
         now,
 
+        now,
+        now,
+
+        now + 300 - utils::seconds_per_hour,
         now,
         now
     };
@@ -316,7 +373,7 @@ void scheduler::reset_aux(bool destructive) {
                 noperation.id = id_v[i];
                 noperation.operation = operations_v[i];
                 noperation.contract = contracts_v[i];
-                noperation.pause = 0;
+                noperation.pause = should_start_paused(id_v[i]) ? 1 : 0;
                 noperation.period = delay_v[i];
                 noperation.timestamp = timestamp_v[i];
             });
@@ -433,6 +490,7 @@ ACTION scheduler::configmoonop(name id, name action, name contract, uint64_t qua
             op.quarter_moon_cycles = quarter_moon_cycles;
             op.start_time = starttime;
             op.pause = 0;
+            op.next_due = moon_op_due_time(starttime, op.last_moon_cycle_id, quarter_moon_cycles);
         });
     } else {
         moonops.emplace(_self, [&](auto & op){
@@ -443,6 +501,7 @@ ACTION scheduler::configmoonop(name id, name action, name contract, uint64_t qua
             op.start_time = starttime;
             op.last_moon_cycle_id = 0;
             op.pause = 0;
+            op.next_due = starttime;
         });
     }
 }
@@ -475,6 +534,15 @@ ACTION scheduler::moonphase(uint64_t timestamp, string phase_name, string eclips
         });
     }
 
+    // moon ops that were waiting for this phase to be added
+    for (auto mitr = moonops.begin(); mitr != moonops.end(); mitr++) {
+        if (mitr->next_due.value_or(0) == std::numeric_limits<uint64_t>::max()) {
+            moonops.modify(mitr, _self, [&](auto & op){
+                op.next_due = moon_op_due_time(op.start_time, op.last_moon_cycle_id, op.quarter_moon_cycles);
+            });
+        }
+    }
+
 }
 
 ACTION scheduler::removeop(name id) {
@@ -557,58 +625,90 @@ ACTION scheduler::execute() {
     // execute operations
     // =======================
 
-    auto ops_by_last_executed = operations.get_index<"bytimestamp"_n>();
-    auto itr = ops_by_last_executed.begin();
-    bool has_executed = false;
+    // ops run per tick, 1 runs a single op like before
+    auto bitr = config.find(ops_per_execution.value);
+    uint64_t max_ops = bitr != config.end() && bitr->value > 0 ? bitr->value : 1;
+
+    uint64_t executed = 0;
+    bool has_more = false;
 
     uint64_t timestamp = eosio::current_time_point().sec_since_epoch();
 
-    while(itr != ops_by_last_executed.end()) {
-        if(is_ready_op(itr -> id, timestamp)){
+    // only ops with next_due <= now are visited
+    auto ops_by_next_due = operations.get_index<"bynextdue"_n>();
+    auto itr = ops_by_next_due.begin();
+
+    while (itr != ops_by_next_due.end() && itr->by_next_due() <= timestamp) {
+        auto next_itr = std::next(itr);
+
+        if (is_ready_op(itr -> id, timestamp)) {
+
+            if (executed == max_ops) {
+                has_more = true;
+                break;
+            }
 
             print("\nOperation to be executed: " + itr -> id.to_string(), "\n");
 
             exec_op(itr->id, itr->contract, itr->operation);
 
-            ops_by_last_executed.modify(itr, _self, [&](auto & operation) {
+            ops_by_next_due.modify(itr, _self, [&](auto & operation) {
                 operation.timestamp = timestamp;
             });
 
-            has_executed = true;
-            
-            break;
+            executed++;
         }
-        itr++;
-    }
 
-    if (!has_executed) {
-        auto moonops_by_last_cycle = moonops.get_index<"bylastcycle"_n>();
-        auto mitr = moonops_by_last_cycle.begin();
-        
-        while (mitr != moonops_by_last_cycle.end()) {
-            uint64_t used_timestamp = is_ready_moon_op(mitr->id, timestamp);
-            if (used_timestamp) {
-                print("\nMoon operation to be executed: " + mitr->id.to_string(), "\n");
+        itr = next_itr;
+    }
 
-                exec_op(mitr->id, mitr->contract, mitr->action);
+    auto moonops_by_next_due = moonops.get_index<"bynextdue"_n>();
+    auto mitr = moonops_by_next_due.begin();
 
-                moonops_by_last_cycle.modify(mitr, _self, [&](auto & operation){
-                    operation.last_moon_cycle_id = used_timestamp;
-                });
+    while (!has_more && mitr != moonops_by_next_due.end() && mitr->by_next_due() <= timestamp) {
+        auto next_mitr = std::next(mitr);
+        uint64_t used_timestamp = is_ready_moon_op(mitr->id, timestamp);
 
-                has_executed = true;
+        if (used_timestamp) {
 
+            if (executed == max_ops) {
+                has_more = true;
                 break;
             }
-            mitr++;
+
+            print("\nMoon operation to be executed: " + mitr->id.to_string(), "\n");
+
+            exec_op(mitr->id, mitr->contract, mitr->action);
+
+            moonops_by_next_due.modify(mitr, _self, [&](auto & operation){
+                operation.last_moon_cycle_id = used_timestamp;
+                operation.next_due = moon_op_due_time(operation.start_time, used_timestamp, operation.quarter_moon_cycles);
+            });
+
+            executed++;
+        } else {
+            moonops_by_next_due.modify(mitr, _self, [&](auto & operation){
+                operation.next_due = moon_op_due_time(operation.start_time, operation.last_moon_cycle_id, operation.quarter_moon_cycles);
+            });
         }
+
+        mitr = next_mitr;
     }
 
     // =======================
     // schedule next execution
     // =======================
 
-    auto it_s = has_executed ? 1 : config.get(seconds_to_execute.value, (contracts::scheduler.to_string() + ": the parameter " + seconds_to_execute.to_string() + " is not configured in " + contracts::settings.to_string()).c_str()).value;
+    // wake up when the next op is due, but at least every secndstoexec seconds to pick up new ops
+    uint64_t max_delay = config.get(seconds_to_execute.value, (contracts::scheduler.to_string() + ": the parameter " + seconds_to_execute.to_string() + " is not configured in " + contracts::settings.to_string()).c_str()).value;
+    uint64_t it_s = 1;
+
+    if (!has_more) {
+        uint64_t next_due = next_due_time();
+        if (next_due > timestamp + 1) {
+            it_s = std::min(next_due - timestamp, max_delay);
+        }
+    }
 
     action next_execution(
         permission_level{get_self(), "active"_n},
@@ -635,13 +735,13 @@ ACTION scheduler::checknext() {
     // check operations
     // =======================
 
-    auto ops_by_last_executed = operations.get_index<"bytimestamp"_n>();
-    auto itr = ops_by_last_executed.begin();
+    auto ops_by_next_due = operations.get_index<"bynextdue"_n>();
+    auto itr = ops_by_next_due.begin();
     bool has_executed = false;
 
     uint64_t timestamp = eosio::current_time_point().sec_since_epoch();
 
-    while(itr != ops_by_last_executed.end()) {
+    while(itr != ops_by_next_due.end() && itr->by_next_due() <= timestamp) {
         print(" checking op " + (itr -> id).to_string());
         if(is_ready_op(itr -> id, timestamp)){
 
@@ -656,12 +756,11 @@ ACTION scheduler::checknext() {
 
     if (!has_executed) {
 
-        auto moonops_by_last_cycle = moonops.get_index<"bylastcycle"_n>();
-        auto mitr = moonops_by_last_cycle.begin();
+        auto moonops_by_next_due = moonops.get_index<"bynextdue"_n>();
+        auto mitr = moonops_by_next_due.begin();
 
-        print(" checking moon op " + (mitr -> id).to_string());
-        
-        while (mitr != moonops_by_last_cycle.end()) {
+        while (mitr != moonops_by_next_due.end() && mitr->by_next_due() <= timestamp) {
+            print(" checking moon op " + (mitr -> id).to_string());
             uint64_t used_timestamp = is_ready_moon_op(mitr->id, timestamp);
             if (used_timestamp) {
                 
@@ -674,6 +773,7 @@ ACTION scheduler::checknext() {
         }
     }
 
+    print(" next due: " + std::to_string(next_due_time()));
 
 }
 
@@ -682,6 +782,37 @@ void scheduler::cancel_exec() {
     cancel_deferred(contracts::scheduler.value);
 }
 
+ACTION scheduler::reindexops() {
+    require_auth(get_self());
+
+    // modify keeps the stored secondary key when the computed one looks unchanged, so rows are
+    // erased and written again to get their bynextdue key from the current fields
+    std::vector<operations_table> ops;
+    auto itr = operations.begin();
+    while (itr != operations.end()) {
+        ops.push_back(*itr);
+        itr = operations.erase(itr);
+    }
+    for (const auto & op : ops) {
+        operations.emplace(_self, [&](auto & item) {
+            item = op;
+        });
+    }
+
+    std::vector<moon_ops_table> mops;
+    auto mitr = moonops.begin();
+    while (mitr != moonops.end()) {
+        mops.push_back(*mitr);
+        mitr = moonops.erase(mitr);
+    }
+    for (const auto & mop : mops) {
+        moonops.emplace(_self, [&](auto & item) {
+            item = mop;
+            item.next_due = moon_op_due_time(mop.start_time, mop.last_moon_cycle_id, mop.quarter_moon_cycles);
+        });
+    }
+}
+
 ACTION scheduler::test1() {
     require_auth(get_self());
 
@@ -772,5 +903,5 @@ EOSIO_DISPATCH(scheduler,
     (configop)(configmoonop)(addmoonop)
     (execute)(reset)(pauseop)(removeop)
     (stop)(start)(moonphase)(test1)(test2)(testexec)(updateops)
-    (checknext)
+    (checknext)(reindexops)
 );
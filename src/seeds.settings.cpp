@@ -68,6 +68,7 @@ void settings::reset() {
 
   confwithdesc(name("htry.trx.max"), 2, "Maximum number of transactions to take into account for transaction score between to users per day", high_impact);
   confwithdesc(name("qev.trx.cap"), uint64_t(1777) * uint64_t(10000), "Maximum number of seeds to take into account as qualifying volume", high_impact);
+  confwithdesc(name("htry.batch"), 50, "Number of queued transfers history saves per transaction", high_impact);
 
   conffloatdsc(name("infation.per"), 0.0, "Economic inflation per period. Example 0.01 = 1%", high_impact);
 
@@ -133,6 +134,7 @@ void settings::reset() {
 
   // Scheduler cycle
   confwithdesc(name("secndstoexec"), 60, "Seconds to execute", high_impact);
+  confwithdesc(name("sched.batch"), 5, "Maximum number of scheduler operations run per execution", high_impact);
 
   // =====================================
   // citizenship path 
@@ -345,6 +347,7 @@ void settings::reset() {
   confwithdesc(name("gratz2.gen"), 200 * 10000, "Base quantity of gratitude tokens received for citizens per cycle", medium_impact);
   confwithdesc(name("gratz.acks"), 10, "Minumum number of gratitude acks to fully use your tokens", medium_impact);
   confwithdesc(name("gratz.potkp"), 50, "Percent to keep on Gratitude Pot at new round", medium_impact);
+  confwithdesc(name("gratz.budget"), 500, "Maximum number of acks calculated per calcacks transaction", low_impact);
 
   // =====================================
   // onboarding/invite
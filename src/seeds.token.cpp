@@ -129,6 +129,45 @@ void token::transfer( const name&    from,
     update_stats( from, to, quantity );
 }
 
+void token::transfermany( const name& from, const std::vector<transfer_entry>& transfers )
+{
+    check( transfers.size() > 0, "seeds: no transfers" );
+    require_auth( from );
+
+    auto sym = transfers[0].quantity.symbol.code();
+    stats statstable( get_self(), sym.raw() );
+    const auto& st = statstable.get( sym.raw() );
+
+    require_recipient( from );
+
+    check_limit_transactions(from, transfers.size());
+
+    asset total(0, st.supply.symbol);
+
+    for (const auto& t : transfers) {
+      check( from != t.to, "seeds: cannot transfer to self" );
+      check( is_account( t.to ), "seeds: to account does not exist");
+      check( t.quantity.is_valid(), "seeds: invalid quantity" );
+      check( t.quantity.amount > 0, "seeds: must transfer positive quantity" );
+      check( t.quantity.symbol == st.supply.symbol, "seeds: symbol precision mismatch" );
+      check( t.memo.size() <= 256, "seeds: memo has more than 256 bytes" );
+
+      require_recipient( t.to );
+
+      auto payer = has_auth( t.to ) ? t.to : from;
+
+      add_balance( t.to, t.quantity, payer );
+
+      total += t.quantity;
+    }
+
+    sub_balance( from, total );
+
+    save_transactions(from, transfers);
+
+    update_stats_many( from, transfers );
+}
+
 void token::sub_balance( const name& owner, const asset& value ) {
    accounts from_acnts( get_self(), owner.value );
 
@@ -171,7 +210,32 @@ void token::save_transaction(name from, name to, asset quantity) {
 
 }
 
-void token::check_limit_transactions(name from) {
+void token::save_transactions(name from, const std::vector<transfer_entry>& transfers) {
+  if (!is_account(contracts::accounts) || !is_account(contracts::history)) {
+    return;
+  }
+
+  std::vector<name> to;
+  std::vector<asset> quantities;
+  to.reserve(transfers.size());
+  quantities.reserve(transfers.size());
+
+  for (const auto& t : transfers) {
+    to.push_back(t.to);
+    quantities.push_back(t.quantity);
+  }
+
+  action(
+    permission_level{contracts::history, "active"_n},
+    contracts::history, 
+    "trxentries"_n,
+    std::make_tuple(from, to, quantities)
+  ).send();
+
+}
+
+// count is the number of transfers about to be made
+void token::check_limit_transactions(name from, uint64_t count) {
   user_tables users(contracts::accounts, contracts::accounts.value);
   config_tables config(contracts::settings, contracts::settings.value);
   balance_tables balances(contracts::harvest, contracts::harvest.value);
@@ -195,7 +259,7 @@ void token::check_limit_transactions(name from) {
     auto titr = transactions.find(from.value);
 
     if (titr != transactions.end()) {
-      check(max_trx > titr -> outgoing_transactions, "Maximum limit of allowed transactions reached.");
+      check(max_trx >= titr -> outgoing_transactions + count, "Maximum limit of allowed transactions reached.");
     }
   }
 }
@@ -319,6 +383,62 @@ void token::update_stats( const name& from, const name& to, const asset& quantit
     }
 }
 
+// update_stats for every transfer, writing each account's row once
+void token::update_stats_many( const name& from, const std::vector<transfer_entry>& transfers ) {
+    user_tables users(contracts::accounts, contracts::accounts.value);
+
+    if (users.find(from.value) == users.end()) {
+      return;
+    }
+
+    struct stats_delta {
+      int64_t volume = 0;
+      uint64_t incoming = 0;
+      uint64_t outgoing = 0;
+    };
+
+    std::map<name, stats_delta> deltas;
+    auto sym = transfers[0].quantity.symbol;
+
+    for (const auto& t : transfers) {
+      auto it = deltas.find(t.to);
+      if (it == deltas.end()) {
+        if (users.find(t.to.value) == users.end()) {
+          continue;
+        }
+        it = deltas.emplace(t.to, stats_delta()).first;
+      }
+      it->second.volume += t.quantity.amount;
+      it->second.incoming += 1;
+
+      stats_delta & from_delta = deltas[from];
+      from_delta.volume += t.quantity.amount;
+      from_delta.outgoing += 1;
+    }
+
+    transaction_tables transactions(get_self(), sym.code().raw());
+
+    for (const auto& [account, delta] : deltas) {
+      auto titr = transactions.find(account.value);
+      if (titr == transactions.end()) {
+        transactions.emplace(get_self(), [&](auto& user) {
+          user.account = account;
+          user.transactions_volume = asset(delta.volume, sym);
+          user.total_transactions = delta.incoming + delta.outgoing;
+          user.incoming_transactions = delta.incoming;
+          user.outgoing_transactions = delta.outgoing;
+        });
+      } else {
+        transactions.modify(titr, get_self(), [&](auto& user) {
+          user.transactions_volume += asset(delta.volume, sym);
+          user.total_transactions += delta.incoming + delta.outgoing;
+          user.incoming_transactions += delta.incoming;
+          user.outgoing_transactions += delta.outgoing;
+        });
+      }
+    }
+}
+
 void token::open( const name& owner, const symbol& symbol, const name& ram_payer )
 {
    require_auth( ram_payer );
@@ -441,5 +561,5 @@ void token::minthrvst (const name& to, const asset& quantity, const string& memo
 
 } /// namespace eosio
 
-EOSIO_DISPATCH( eosio::token, (create)(issue)(transfer)(open)(close)(retire)(burn)(resetweekly)(resetwhelper)(updatecirc)(minthrvst) )
+EOSIO_DISPATCH( eosio::token, (create)(issue)(transfer)(transfermany)(open)(close)(retire)(burn)(resetweekly)(resetwhelper)(updatecirc)(minthrvst) )
   
\ No newline at end of file
@@ -300,7 +300,7 @@ describe('General accounts', async assert => {
     const escrows = await getTableRows({
       code: escrow,
       scope: escrow,
-      table: 'locks',
+      table: 'tokenlocks',
       lower_bound: id,
       upper_bound: id,
       json: true
@@ -313,7 +313,8 @@ describe('General accounts', async assert => {
     delete item.vesting_date
     delete item.notes
     delete item.created_date
-    delete item.updated_date
+    delete item.proposal_contract
+    delete item.proposal_id
 
     assert({
       given: text,
@@ -660,7 +661,7 @@ describe('Ambassador and Org rewards', async assert => {
     const escrows = await getTableRows({
       code: escrow,
       scope: escrow,
-      table: 'locks',
+      table: 'tokenlocks',
       json: true
     })
     //console.log("escrow: "+JSON.stringify(escrows, null, 2))
@@ -673,7 +674,8 @@ describe('Ambassador and Org rewards', async assert => {
       delete item.vesting_date
       delete item.notes
       delete item.created_date
-      delete item.updated_date
+      delete item.proposal_contract
+      delete item.proposal_id
     })
 
     assert({
@@ -760,7 +762,7 @@ describe('Proportional rewards', async assert => {
     const escrows = await getTableRows({
       code: escrow,
       scope: escrow,
-      table: 'locks',
+      table: 'tokenlocks',
       json: true
     })
     //console.log("escrow: "+JSON.stringify(escrows, null, 2))
@@ -772,7 +774,8 @@ describe('Proportional rewards', async assert => {
     delete item.vesting_date
     delete item.notes
     delete item.created_date
-    delete item.updated_date
+    delete item.proposal_contract
+    delete item.proposal_id
 
     assert({
       given: text,
@@ -1214,6 +1217,252 @@ describe('reputation & cbs ranking', async assert => {
 
 })
 
+describe('rep changes during ranking', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ accounts })
+
+  console.log('reset accounts')
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+
+  console.log('add users')
+  await contracts.accounts.adduser(firstuser, 'First user', "individual", { authorization: `${accounts}@active` })
+  await contracts.accounts.adduser(seconduser, 'Second user', "individual", { authorization: `${accounts}@active` })
+  await contracts.accounts.adduser(thirduser, '3 user', "individual", { authorization: `${accounts}@active` })
+
+  await contracts.accounts.addrep(firstuser, 10, { authorization: `${accounts}@api` })
+  await contracts.accounts.addrep(seconduser, 20, { authorization: `${accounts}@api` })
+  await contracts.accounts.addrep(thirduser, 30, { authorization: `${accounts}@api` })
+
+  console.log('rank one rep per chunk')
+  await contracts.accounts.rankrep(0, 0, 1, accounts, { authorization: `${accounts}@active` })
+
+  console.log('add rep while ranking')
+  await contracts.accounts.addrep(firstuser, 100, { authorization: `${accounts}@api` })
+
+  const getPending = async () => (await getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'reppending',
+    json: true
+  })).rows
+
+  const pendingDuringRanking = await getPending()
+  const repsDuringRanking = await get_reps()
+
+  await sleep(4000)
+
+  const pendingAfterRanking = await getPending()
+  const repsAfterRanking = await get_reps()
+
+  const ranks = (await getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'rep',
+    json: true
+  })).rows.map(({ rank }) => rank)
+
+  const repCounts = (await getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'repcounts',
+    json: true
+  })).rows
+
+  assert({
+    given: 'rep added while ranking',
+    should: 'be buffered',
+    actual: [pendingDuringRanking, repsDuringRanking],
+    expected: [[{ account: firstuser, delta: 100 }], [10, 20, 30]]
+  })
+
+  assert({
+    given: 'ranking finished',
+    should: 'merge the buffered rep',
+    actual: [pendingAfterRanking, repsAfterRanking],
+    expected: [[], [110, 20, 30]]
+  })
+
+  assert({
+    given: 'ranking finished',
+    should: 'rank every account once',
+    actual: ranks,
+    expected: [0, 8, 50]
+  })
+
+  assert({
+    given: 'ranking finished',
+    should: 'count accounts per rep value',
+    actual: repCounts,
+    expected: [{ rep: 20, count: 1 }, { rep: 30, count: 1 }, { rep: 110, count: 1 }]
+  })
+
+})
+
+describe('addreps', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ accounts })
+
+  console.log('reset accounts')
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+
+  console.log('add users')
+  await contracts.accounts.adduser(firstuser, 'First user', "individual", { authorization: `${accounts}@active` })
+  await contracts.accounts.adduser(seconduser, 'Second user', "individual", { authorization: `${accounts}@active` })
+  await contracts.accounts.adduser(thirduser, '3 user', "individual", { authorization: `${accounts}@active` })
+
+  await contracts.accounts.addrep(firstuser, 10, { authorization: `${accounts}@api` })
+  await contracts.accounts.addrep(seconduser, 20, { authorization: `${accounts}@api` })
+
+  const getDirty = async () => (await getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'repdirty',
+    json: true
+  })).rows.map(({ account }) => account)
+
+  console.log('add many reps')
+  await contracts.accounts.addreps([
+    { first: firstuser, second: 5 },
+    { first: seconduser, second: -20 },
+    { first: thirduser, second: 30 },
+    { first: 'nosuchuser', second: 1 }
+  ], { authorization: `${accounts}@active` })
+
+  const reps = await get_reps()
+  const dirty = await getDirty()
+
+  console.log('rank reps')
+  await contracts.accounts.rankreps({ authorization: `${accounts}@active` })
+  await sleep(2000)
+
+  const dirtyAfterRanking = await getDirty()
+
+  assert({
+    given: 'addreps called',
+    should: 'apply every rep change and skip unknown users',
+    actual: reps,
+    expected: [15, 30]
+  })
+
+  assert({
+    given: 'addreps called',
+    should: 'mark the changed accounts dirty',
+    actual: dirty,
+    expected: [firstuser, seconduser, thirduser]
+  })
+
+  assert({
+    given: 'reps ranked',
+    should: 'clear the dirty accounts',
+    actual: dirtyAfterRanking,
+    expected: []
+  })
+
+})
+
+describe('addreps rerank', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ accounts })
+
+  console.log('reset accounts')
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+
+  const users = [firstuser, seconduser, thirduser, fourthuser]
+
+  const getRanks = async () => {
+    const rows = (await getTableRows({
+      code: accounts,
+      scope: accounts,
+      table: 'rep',
+      json: true
+    })).rows
+    return users.map(user => (rows.filter(r => r.account === user)[0] || { rank: null }).rank)
+  }
+
+  const getChanges = async () => {
+    const sizes = await getTableRows({
+      code: accounts,
+      scope: accounts,
+      table: 'sizes',
+      json: true
+    })
+    const row = sizes.rows.filter(r => r.id === 'rep.chg.sz')[0]
+    return row ? parseInt(row.size) : 0
+  }
+
+  console.log('add users with rep 10 to 40 and rank them')
+  for (const user of users) {
+    await contracts.accounts.adduser(user, user, 'individual', { authorization: `${accounts}@active` })
+  }
+  await contracts.accounts.addreps(users.map((user, index) => ({ first: user, second: 10 * (index + 1) })), { authorization: `${accounts}@active` })
+  await contracts.accounts.rankrep(0, 0, 200, accounts, { authorization: `${accounts}@active` })
+  await sleep(2000)
+
+  const ranked = await getRanks()
+
+  console.log('move the lowest rep to the top and rerank the changed accounts')
+  await contracts.accounts.addreps([{ first: firstuser, second: 100 }], { authorization: `${accounts}@active` })
+  const changesAfterAdd = await getChanges()
+
+  await contracts.accounts.rerankrep(accounts, 200, { authorization: `${accounts}@active` })
+  const reranked = await getRanks()
+
+  console.log('rank reps')
+  await contracts.accounts.rankreps({ authorization: `${accounts}@active` })
+  await sleep(2000)
+
+  const fullyRanked = await getRanks()
+  const changesAfterRanking = await getChanges()
+
+  console.log('drop a rep to zero')
+  await contracts.accounts.addreps([{ first: seconduser, second: -1000 }], { authorization: `${accounts}@active` })
+  const changesAfterRemove = await getChanges()
+
+  assert({
+    given: 'reps ranked',
+    should: 'rank by position',
+    actual: ranked,
+    expected: [0, 4, 27, 63]
+  })
+
+  assert({
+    given: 'rerankrep after one change',
+    should: 'rerank only the changed account and leave the others stale',
+    actual: [changesAfterAdd, reranked],
+    expected: [1, [63, 4, 27, 63]]
+  })
+
+  assert({
+    given: 'changes over 0.1% of the reps',
+    should: 'run a full ranking and reset the change count',
+    actual: [changesAfterRanking, fullyRanked],
+    expected: [0, [63, 0, 4, 27]]
+  })
+
+  assert({
+    given: 'a rep dropped to zero',
+    should: 'erase it and count it as a change',
+    actual: [changesAfterRemove, await getRanks()],
+    expected: [1, [63, null, 4, 27]]
+  })
+
+})
+
 describe('Referral cbp reward individual', async assert => {
 
 
@@ -1851,6 +2100,29 @@ describe('Delegate flagging', async assert => {
     actual: flagPoints.rows.map(r => r.account)
   })
 
+  const totalFlags = await getTableRows({
+    code: accounts,
+    scope: 'flag.total',
+    table: 'flagpts',
+    lower_bound: fifthuser,
+    upper_bound: fifthuser,
+    json: true
+  })
+
+  const flagQueue = await getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'flagqueue',
+    json: true
+  })
+
+  assert({
+    given: 'flag delegated',
+    should: 'add up the flag points of the whole tree and empty the queue',
+    expected: [flagPoints.rows.reduce((sum, r) => sum + r.flag_points, 0), 0],
+    actual: [totalFlags.rows[0].flag_points, flagQueue.rows.length]
+  })
+
   const delegatorsTable = await getTableRows({
     code: accounts,
     scope: accounts,
@@ -2066,3 +2338,80 @@ describe('Enforce accounts', async assert => {
 })
 
 
+describe('Ban referral tree', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ accounts, settings })
+
+  console.log('reset')
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+  await contracts.settings.reset({ authorization: `${settings}@active` })
+
+  console.log('one referral per batch')
+  await contracts.settings.configure('batchsize', 1, { authorization: `${settings}@active` })
+
+  await contracts.accounts.addref(firstuser, seconduser, { authorization: `${accounts}@api` })
+  await contracts.accounts.addref(firstuser, thirduser, { authorization: `${accounts}@api` })
+  await contracts.accounts.addref(seconduser, fourthuser, { authorization: `${accounts}@api` })
+
+  console.log('ban tree')
+  await contracts.accounts.bantree(firstuser, true, { authorization: `${accounts}@active` })
+
+  const getBanned = async () => (await getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'ban',
+    json: true
+  })).rows.map(({ account }) => account).sort()
+
+  const bannedAfterFirstBatch = await getBanned()
+
+  // queue pops count toward the batch too
+  await sleep(8000)
+
+  const bannedAfterTree = await getBanned()
+
+  const queue = await getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'banqueue',
+    json: true
+  })
+
+  const progress = await getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'sizes',
+    lower_bound: 'bantree.sz',
+    upper_bound: 'bantree.sz',
+    json: true
+  })
+
+  await contracts.settings.reset({ authorization: `${settings}@active` })
+
+  assert({
+    given: 'bantree called',
+    should: 'ban the account and one referral in the first batch',
+    actual: bannedAfterFirstBatch,
+    expected: [firstuser, seconduser].sort()
+  })
+
+  assert({
+    given: 'all batches run',
+    should: 'ban the whole referral tree',
+    actual: bannedAfterTree,
+    expected: [firstuser, seconduser, thirduser, fourthuser].sort()
+  })
+
+  assert({
+    given: 'all batches run',
+    should: 'empty the queue and count the banned referrals',
+    actual: [queue.rows.length, progress.rows[0].size],
+    expected: [0, 3]
+  })
+
+})
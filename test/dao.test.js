@@ -129,8 +129,16 @@ async function resetContracts () {
   await Promise.all(users.map(user => contracts.accounts.testcitizen(user, { authorization: `${accounts}@active` })))
 }
 
+// voice rows hold their balance as of their last write, decay since then is in the cycle table's decay_index
 async function getVoice (account) {
   const voice = []
+  const cycle = await getTableRows({
+    code: dao,
+    scope: dao,
+    table: 'cycle',
+    json: true
+  })
+  const { decay_index = 0, decay_epoch = 0 } = cycle.rows[0] || {}
   for (const s of scopes) {
     const voiceTable = await getTableRows({
       code: dao,
@@ -141,9 +149,12 @@ async function getVoice (account) {
       limit: 1
     })
     if (voiceTable.rows.length > 0) {
+      const row = voiceTable.rows[0]
+      const decay = parseFloat(row.decay_index || 0) - parseFloat(decay_index)
       voice.push({
         scope: s,
-        ...voiceTable.rows[0]
+        account: row.account,
+        balance: (row.decay_epoch || 0) != decay_epoch ? 0 : Math.floor(row.balance * Math.exp(decay) + 0.000001)
       })
     }
   }
@@ -1677,7 +1688,7 @@ describe('Alliance Proposals', async assert => {
   const escrowTable = await getTableRows({
     code: escrow,
     scope: escrow,
-    table: 'locks',
+    table: 'tokenlocks',
     json: true
   })
 
@@ -1687,7 +1698,6 @@ describe('Alliance Proposals', async assert => {
     actual: escrowTable.rows.map(r => {
       delete r.vesting_date
       delete r.created_date
-      delete r.updated_date
       return r
     }),
     expected:   [
@@ -1699,6 +1709,8 @@ describe('Alliance Proposals', async assert => {
         quantity: '10000.0000 SEEDS',
         trigger_event: 'golive',
         trigger_source: 'dao.hypha',
+        proposal_contract: 'dao.seeds',
+        proposal_id: 1,
         notes: 'proposal_id: 1'
       },
       {
@@ -1709,6 +1721,8 @@ describe('Alliance Proposals', async assert => {
         quantity: '1000000.0000 SEEDS',
         trigger_event: 'golive',
         trigger_source: 'dao.hypha',
+        proposal_contract: 'dao.seeds',
+        proposal_id: 2,
         notes: 'proposal_id: 2'
       }
     ]
@@ -1792,7 +1806,7 @@ describe('Alliance Proposals', async assert => {
   const escrowTableBefore = await getTableRows({
     code: escrow,
     scope: escrow,
-    table: 'locks',
+    table: 'tokenlocks',
     json: true
   })
 
@@ -1851,7 +1865,7 @@ describe('Alliance Proposals', async assert => {
   const escrowTableAfter = await getTableRows({
     code: escrow,
     scope: escrow,
-    table: 'locks',
+    table: 'tokenlocks',
     json: true
   })
 
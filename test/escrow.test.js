@@ -1,7 +1,7 @@
 const { describe } = require("riteway")
 const { eos, names, getTableRows, isLocal, sleep, initContracts } = require("../scripts/helper")
 const { equals } = require("ramda")
-const { escrow, accounts, token, firstuser, seconduser, thirduser, pool, fourthuser, settings } = names
+const { escrow, accounts, token, firstuser, seconduser, thirduser, pool, fourthuser, settings, proposals, dao } = names
 const moment = require('moment')
 
 describe('vest and escrow', async assert => {
@@ -50,7 +50,7 @@ describe('vest and escrow', async assert => {
     const initialEscrows = await getTableRows({
         code: escrow,
         scope: escrow,
-        table: 'locks',
+        table: 'tokenlocks',
         json: true
     })
 
@@ -86,7 +86,7 @@ describe('vest and escrow', async assert => {
     const escrows = await getTableRows({
         code: escrow,
         scope: escrow,
-        table: 'locks',
+        table: 'tokenlocks',
         json: true
     })
 
@@ -111,7 +111,7 @@ describe('vest and escrow', async assert => {
     const escrowsAfter = await getTableRows({
         code: escrow,
         scope: escrow,
-        table: 'locks',
+        table: 'tokenlocks',
         json: true
     })
 
@@ -169,7 +169,7 @@ describe('vest and escrow', async assert => {
     const severalEscrowsBeforeClaim = await getTableRows({
         code: escrow,
         scope: escrow,
-        table: 'locks',
+        table: 'tokenlocks',
         json: true
     })
     
@@ -191,7 +191,7 @@ describe('vest and escrow', async assert => {
     const severalEscrowsAfter = await getTableRows({
         code: escrow,
         scope: escrow,
-        table: 'locks',
+        table: 'tokenlocks',
         json: true
     })
 
@@ -222,7 +222,6 @@ describe('vest and escrow', async assert => {
     let iinitialEscrowRows = initialEscrows.rows.map( row => {
         delete row.vesting_date
         delete row.created_date
-        delete row.updated_date
         return row
     })
 
@@ -239,6 +238,8 @@ describe('vest and escrow', async assert => {
                 "quantity": "20.0000 SEEDS",
                 "trigger_event": "",
                 "trigger_source": "firstuser",
+                "proposal_contract": "",
+                "proposal_id": 0,
                 "notes": "notes",
               },
               {
@@ -249,6 +250,8 @@ describe('vest and escrow', async assert => {
                 "quantity": "50.0000 SEEDS",
                 "trigger_event": "",
                 "trigger_source": "seconduser",
+                "proposal_contract": "",
+                "proposal_id": 0,
                 "notes": "notes",
               }
         ]
@@ -366,7 +369,7 @@ describe('go live', async assert => {
         const lockTable = await eos.getTableRows({
           code: escrow,
           scope: escrow,
-          table: 'locks',
+          table: 'tokenlocks',
           json: true,
         })
         const locks = lockTable.rows.map(r => {
@@ -496,3 +499,75 @@ describe('go live', async assert => {
     })
 
 })
+
+describe('migrate locks', async assert => {
+
+    if (!isLocal()) {
+        console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+        return
+    }
+
+    const contracts = await initContracts({ escrow })
+
+    console.log('escrow reset')
+    await contracts.escrow.reset({ authorization: `${escrow}@active` })
+
+    console.log('write legacy locks')
+    const legacyNotes = ['proposal id: 7', 'proposal_id: 12', 'proposal id: abc', 'notes']
+    for (const notes of legacyNotes) {
+        await contracts.escrow.testlgcylock(firstuser, seconduser, '1.0000 SEEDS', notes, { authorization: `${escrow}@active` })
+    }
+
+    let pendingError = ''
+    try {
+        console.log('claim while locks are not migrated')
+        await contracts.escrow.claim(seconduser, { authorization: `${seconduser}@active` })
+    } catch (err) {
+        pendingError = err.toString()
+    }
+
+    console.log('migrate locks')
+    await contracts.escrow.migratelocks(2, { authorization: `${escrow}@active` })
+    await sleep(3000)
+
+    const legacyAfter = await getTableRows({
+        code: escrow,
+        scope: escrow,
+        table: 'locks',
+        json: true
+    })
+
+    const migrated = await getTableRows({
+        code: escrow,
+        scope: escrow,
+        table: 'tokenlocks',
+        json: true
+    })
+
+    assert({
+        given: 'locks not migrated yet',
+        should: 'refuse to claim',
+        actual: pendingError.includes('locks migration pending'),
+        expected: true
+    })
+
+    assert({
+        given: 'migratelocks ran in chunks of 2',
+        should: 'empty the legacy locks table',
+        actual: legacyAfter.rows.length,
+        expected: 0
+    })
+
+    assert({
+        given: 'migrated locks',
+        should: 'keep their ids and read the proposal from the notes, skipping malformed ones',
+        actual: migrated.rows.map(({ id, beneficiary, proposal_contract, proposal_id, notes }) => ({ id, beneficiary, proposal_contract, proposal_id, notes })),
+        expected: [
+            { id: 0, beneficiary: seconduser, proposal_contract: proposals, proposal_id: 7, notes: legacyNotes[0] },
+            { id: 1, beneficiary: seconduser, proposal_contract: dao, proposal_id: 12, notes: legacyNotes[1] },
+            { id: 2, beneficiary: seconduser, proposal_contract: '', proposal_id: 0, notes: legacyNotes[2] },
+            { id: 3, beneficiary: seconduser, proposal_contract: '', proposal_id: 0, notes: legacyNotes[3] }
+        ]
+    })
+
+})
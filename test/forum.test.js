@@ -3,7 +3,7 @@ const { eos, names, isLocal, getTableRows } = require('../scripts/helper')
 const { equals } = require('ramda');
 const { expect, use } = require('chai');
 
-const { forum, scheduler, accounts, settings, application, firstuser, seconduser, thirduser } = names
+const { forum, scheduler, accounts, settings, application, firstuser, seconduser, thirduser, fourthuser } = names
 
 
 function sleep(ms) {
@@ -400,9 +400,55 @@ describe('forum reputation', async assert => {
     })
 })
 
+describe('forum ranking resume', async assert => {
 
+    if (!isLocal()) {
+        console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+        return
+    }
+
+    const contracts = await Promise.all([
+        eos.contract(forum),
+        eos.contract(accounts)
+    ]).then(([forum, accounts]) => ({
+        forum, accounts
+    }))
 
+    console.log('forum reset')
+    await contracts.forum.reset({ authorization: `${forum}@active` })
 
+    console.log('accounts reset')
+    await contracts.accounts.reset({ authorization: `${accounts}@active` })
 
+    const users = [firstuser, seconduser, thirduser, fourthuser]
 
+    console.log('join users and post')
+    for (let i = 0; i < users.length; i++) {
+        await contracts.accounts.adduser(users[i], `user ${i}`, 'individual', { authorization: `${accounts}@active` })
+        await contracts.forum.createpost(users[i], i + 1, `url${i}`, `body${i}`, { authorization: `${users[i]}@active` })
+    }
+
+    console.log('rank one account per chunk')
+    await contracts.forum.rankforum(0, '', 0, 1, 0, { authorization: `${forum}@active` })
+    await sleep(5000)
 
+    const forumReputation = await getTableRows({
+        code: forum,
+        scope: forum,
+        table: 'forumrep',
+        json: true
+    })
+
+    assert({
+        given: 'every chunk boundary inside the same reputation',
+        should: 'rank each account once, in account order',
+        expected: [
+            { account: firstuser, reputation: 0, rank: 0 },
+            { account: seconduser, reputation: 0, rank: 4 },
+            { account: thirduser, reputation: 0, rank: 27 },
+            { account: fourthuser, reputation: 0, rank: 63 }
+        ],
+        actual: forumReputation.rows
+    })
+
+})
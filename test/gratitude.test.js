@@ -247,17 +247,11 @@ describe('gratitude many acks', async assert => {
     const acksTable = await getTableRows({
       code: 'gratz.seeds',
       scope: 'gratz.seeds',
-      table: 'acks',
+      table: 'ackdonors',
       json: true
     })
-    if (acksTable.rows) {
-      var acks =  acksTable.rows.reduce(function(map, obj) {
-        map[obj.donor] = obj.receivers;
-        return map;
-      }, {})
-      return acks[account]
-    }
-    return 0;
+    const donor = acksTable.rows.find(({ donor }) => donor == account)
+    return donor ? donor.num_acks : 0
   }
 
   const checkUserAcks = async (user, expected) => {
@@ -265,7 +259,7 @@ describe('gratitude many acks', async assert => {
     assert({
       given: `${user} performed ack`,
       should: 'have the correct num acks',
-      actual: acks.length,
+      actual: acks,
       expected: expected
     })
   }
@@ -371,6 +365,163 @@ describe('gratitude many acks', async assert => {
   })
 })
 
+describe('gratitude calcacks batches', async assert => {
+
+  const get_settings = async (key) => {
+    const value = await eos.getTableRows({
+      code: settings,
+      scope: settings,
+      table: 'config',
+      lower_bound: key,
+      upper_bound: key,
+      json: true,
+    })
+    return value.rows[0].value
+  }
+
+  // amounts in GRATZ units (4 decimals)
+  const toUnits = quantity => Math.round(parseFloat(quantity) * 10000)
+
+  const getBalanceRow = async account => {
+    const balanceTable = await getTableRows({
+      code: gratitude,
+      scope: gratitude,
+      table: 'balances',
+      json: true
+    })
+    return balanceTable.rows.find(r => r.account == account)
+  }
+
+  const getDonors = async () => {
+    const donorsTable = await getTableRows({
+      code: gratitude,
+      scope: gratitude,
+      table: 'ackdonors',
+      json: true
+    })
+    return donorsTable.rows.map(({ donor }) => donor)
+  }
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ gratitude, accounts, settings, token })
+
+  console.log('accounts reset')
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+  
+  console.log('token reset weekly')
+  await contracts.token.resetweekly({ authorization: `${token}@active` })
+
+  console.log('reset settings')
+  await contracts.settings.reset({ authorization: `${settings}@active` })
+
+  console.log('gratitude reset')
+  await contracts.gratitude.reset({ authorization: `${gratitude}@active` })
+
+  // 3 donors per transaction but at most 3 acks, so firstuser's 3 acks fill the first batch alone,
+  // second and third user share the second one and fourthuser's 2 acks would take it over the budget
+  await contracts.settings.configure("batchsize", 3, { authorization: `${settings}@active` })
+  await contracts.settings.configure("gratz.budget", 3, { authorization: `${settings}@active` })
+
+  console.log('add SEEDS users')
+  const users = [firstuser, seconduser, thirduser, fourthuser]
+  for (const user of users) {
+    await contracts.accounts.adduser(user, '', 'individual', { authorization: `${accounts}@active` })
+    await contracts.accounts.testresident(user, { authorization: `${accounts}@active` })
+  }
+
+  const initialGratitude = await get_settings("gratz1.gen")
+  const gratzAcks = await get_settings("gratz.acks")
+
+  // what _calc_acks gives per ack for a donor with numAcks acks
+  const perAck = numAcks => Math.floor(initialGratitude / Math.max(numAcks, gratzAcks))
+
+  console.log('refill gratitude contract')
+  await contracts.token.transfer(firstuser, gratitude, '1000.0000 SEEDS', 'test', { authorization: `${firstuser}@active` })
+
+  const acks = [
+    [firstuser, seconduser],
+    [firstuser, thirduser],
+    [firstuser, fourthuser],
+    [seconduser, firstuser],
+    [thirduser, firstuser],
+    [fourthuser, firstuser],
+    [fourthuser, seconduser],
+  ]
+
+  console.log('acknowledge')
+  for (const [from, to] of acks) {
+    await contracts.gratitude.acknowledge(from, to, 'Thanks!', { authorization: `${from}@active` })
+  }
+
+  console.log('calculate the first batch')
+  await contracts.gratitude.calcacks(0, { authorization: `${gratitude}@active` })
+
+  const donorsAfterFirst = await getDonors()
+  const first = await getBalanceRow(firstuser)
+  const second = await getBalanceRow(seconduser)
+  const third = await getBalanceRow(thirduser)
+
+  assert({
+    given: 'first calcacks transaction',
+    should: 'stop before the donor that would go over gratz.budget',
+    actual: donorsAfterFirst,
+    expected: [seconduser, thirduser, fourthuser]
+  })
+
+  assert({
+    given: 'first calcacks transaction',
+    should: 'give the first donor gratitude',
+    actual: toUnits(first.remaining),
+    expected: initialGratitude - 3 * perAck(3)
+  })
+
+  assert({
+    given: 'first calcacks transaction',
+    should: 'flush what the receivers got from the first donor',
+    actual: [toUnits(second.received), toUnits(third.received)],
+    expected: [perAck(3), perAck(3)]
+  })
+
+  assert({
+    given: 'first calcacks transaction',
+    should: 'not touch donors left for the next batch',
+    actual: toUnits(second.remaining),
+    expected: initialGratitude
+  })
+
+  await sleep(5000) // wait for the remaining batches and the payout
+
+  const donorsAfter = await getDonors()
+
+  const statsTable = await getTableRows({
+    code: gratitude,
+    scope: gratitude,
+    table: 'stats2',
+    json: true
+  })
+  const round = statsTable.rows[0]
+
+  const expectedVolume = 3 * perAck(3) + perAck(1) + perAck(1) + 2 * perAck(2)
+
+  assert({
+    given: 'calcacks batches finished',
+    should: 'calculate every donor',
+    actual: donorsAfter,
+    expected: []
+  })
+
+  assert({
+    given: 'calcacks batches finished',
+    should: 'have the same round stats as calculating donor by donor',
+    actual: [round.num_acks, round.num_transfers, toUnits(round.volume)],
+    expected: [acks.length, acks.length, expectedVolume]
+  })
+})
+
 describe('testing pot keep', async assert => {
  
   const getGratitudeStats = async () => {
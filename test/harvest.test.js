@@ -949,6 +949,105 @@ describe('contribution score', async assert => {
 
 })
 
+describe("fused ranking", async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ accounts, token, harvest, settings, history })
+
+  console.log('settings reset')
+  await contracts.settings.reset({ authorization: `${settings}@active` })
+
+  console.log('harvest reset')
+  await contracts.harvest.reset({ authorization: `${harvest}@active` })
+
+  console.log('accounts reset')
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+
+  console.log('reset token stats')
+  await contracts.token.resetweekly({ authorization: `${token}@active` })
+
+  const users = [firstuser, seconduser, thirduser]
+
+  console.log('join users')
+  for (let i = 0; i < users.length; i++) {
+    const user = users[i]
+    await contracts.accounts.adduser(user, user, 'individual', { authorization: `${accounts}@active` })
+    await contracts.accounts.testsetrs(user, 50, { authorization: `${accounts}@active` })
+    await contracts.history.reset(user, { authorization: `${history}@active` })
+    await contracts.token.transfer(user, harvest, `${100 * (i+1)}.0000 SEEDS`, '', { authorization: `${user}@active` })
+  }
+
+  await contracts.token.transfer(firstuser, seconduser, '10.0000 SEEDS', '', { authorization: `${firstuser}@active` })
+  await contracts.token.transfer(seconduser, thirduser, '10.0000 SEEDS', '', { authorization: `${seconduser}@active` })
+  await sleep(3000)
+
+  await contracts.harvest.calctrxpts({ authorization: `${harvest}@active` })
+  await sleep(1000)
+
+  console.log('rank all')
+  await contracts.harvest.rankalls({ authorization: `${harvest}@active` })
+  await sleep(3000)
+
+  const getRanks = async (table) => {
+    const { rows } = await eos.getTableRows({
+      code: harvest,
+      scope: harvest,
+      table,
+      json: true,
+      limit: 100
+    })
+    return rows.map(({ rank }) => rank)
+  }
+
+  const cursor = await eos.getTableRows({
+    code: harvest,
+    scope: harvest,
+    table: 'rankcursor',
+    json: true
+  })
+
+  const plantedRanks = await getRanks('planted')
+  const txRanks = await getRanks('txpoints')
+  const csRanks = await getRanks('cspoints')
+
+  console.log('planted, tx, cs ranks', plantedRanks, txRanks, csRanks)
+
+  assert({
+    given: 'fused ranking finished',
+    should: 'be in the done phase',
+    actual: cursor.rows[0].phase,
+    expected: 'done'
+  })
+
+  assert({
+    given: 'fused ranking',
+    should: 'rank planted by amount',
+    actual: plantedRanks,
+    expected: [0, 8, 50]
+  })
+
+  // only the senders get tx points, both sent 10 SEEDS to rep 50 so the tie goes to the lower account
+  assert({
+    given: 'fused ranking',
+    should: 'rank tx points',
+    actual: txRanks,
+    expected: [0, 27]
+  })
+
+  // cs = (planted + tx) * rep * 2 / 100: firstuser 0 (no row), seconduser 8 + 27, thirduser 50
+  assert({
+    given: 'fused ranking',
+    should: 'rank contribution scores',
+    actual: csRanks,
+    expected: [0, 50]
+  })
+
+})
+
 describe("plant for other user", async assert => {
 
   if (!isLocal()) {
@@ -1512,7 +1611,7 @@ describe('Mint Rate and Harvest, dSeeds > 0', async assert => {
   const escrowT = await getTableRows({
     code: escrow,
     scope: escrow,
-    table: 'locks',
+    table: 'tokenlocks',
     json: true
   })
   console.log(escrowT)
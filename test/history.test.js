@@ -1083,3 +1083,131 @@ describe('Transaction CBS', async assert => {
 
 })
 
+
+describe('save queued transfers in batches', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ history, accounts, settings })
+
+  const day = getBeginningOfDayInSeconds()
+
+  console.log('reset')
+  await contracts.settings.reset({ authorization: `${settings}@active` })
+  await contracts.history.reset(firstuser, { authorization: `${history}@active` })
+  await contracts.history.reset(history, { authorization: `${history}@active` })
+  await contracts.history.deldailytrx(day, { authorization: `${history}@active` })
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+
+  await contracts.accounts.adduser(firstuser, '', 'individual', { authorization: `${accounts}@active` })
+  await contracts.accounts.adduser(seconduser, '', 'individual', { authorization: `${accounts}@active` })
+  await contracts.accounts.adduser(thirduser, '', 'individual', { authorization: `${accounts}@active` })
+  await contracts.accounts.testsetrs(seconduser, 49, { authorization: `${accounts}@active` })
+  await contracts.accounts.testsetrs(thirduser, 49, { authorization: `${accounts}@active` })
+
+  console.log('queue 4 transfers, 2 per batch')
+  await contracts.settings.configure('htry.batch', 2, { authorization: `${settings}@active` })
+
+  await contracts.history.trxentry(firstuser, seconduser, '10.0000 SEEDS', { authorization: `${history}@active` })
+  await contracts.history.trxentry(firstuser, seconduser, '20.0000 SEEDS', { authorization: `${history}@active` })
+  await contracts.history.trxentry(firstuser, thirduser, '30.0000 SEEDS', { authorization: `${history}@active` })
+  await contracts.history.trxentry(firstuser, thirduser, '40.0000 SEEDS', { authorization: `${history}@active` })
+
+  await sleep(5000)
+
+  const queue = await getTableRows({
+    code: history,
+    scope: history,
+    table: 'trxqueue',
+    json: true
+  })
+
+  const trxPoints = await getTableRows({
+    code: history,
+    scope: firstuser,
+    table: 'trxpoints',
+    json: true
+  })
+
+  const qevs = await getTableRows({
+    code: history,
+    scope: firstuser,
+    table: 'qevs',
+    json: true
+  })
+
+  const totals = await getTableRows({
+    code: history,
+    scope: history,
+    table: 'totals',
+    json: true
+  })
+
+  assert({
+    given: 'transfers queued',
+    should: 'have drained the queue',
+    actual: queue.rows,
+    expected: []
+  })
+
+  assert({
+    given: 'transfers saved in 2 batches',
+    should: 'have summed the points and volume of all transfers',
+    actual: [trxPoints.rows, qevs.rows],
+    expected: [
+      [{ timestamp: day, points: 100 }],
+      [{ timestamp: day, qualifying_volume: 100 * 10000 }]
+    ]
+  })
+
+  const windowBefore = await getTableRows({
+    code: history,
+    scope: history,
+    table: 'trxwindow',
+    json: true
+  })
+
+  console.log('expire the window')
+  await contracts.settings.conffloat('cyctrx.trail', 0, { authorization: `${settings}@active` })
+  await contracts.history.expiretrxs({ authorization: `${history}@active` })
+
+  const windowAfter = await getTableRows({
+    code: history,
+    scope: history,
+    table: 'trxwindow',
+    json: true
+  })
+
+  assert({
+    given: 'transfers saved',
+    should: 'have the running window sum',
+    actual: windowBefore.rows.map(({ account, points }) => ({ account, points })),
+    expected: [{ account: firstuser, points: 100 }]
+  })
+
+  assert({
+    given: 'all days outside the window',
+    should: 'drop the window',
+    actual: windowAfter.rows,
+    expected: []
+  })
+
+  assert({
+    given: 'transfers saved in 2 batches',
+    should: 'have the totals of all transfers',
+    actual: totals.rows,
+    expected: [
+      {
+        account: firstuser,
+        total_volume: 100 * 10000,
+        total_number_of_transactions: 4,
+        total_incoming_from_rep_orgs: 0,
+        total_outgoing_to_rep_orgs: 0
+      }
+    ]
+  })
+
+})
@@ -454,6 +454,100 @@ describe('Use application permission to accept', async assert => {
 
 })
 
+describe('Accept a batch of invites', async assert => {
+
+    if (!isLocal()) {
+        console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+        return
+    }
+
+    const contracts = await initContracts({ onboarding, token, accounts, harvest })
+
+    const transferQuantity = '1.0000 SEEDS'
+    const sowQuantity = '5.0000 SEEDS'
+    const batchSize = 3
+
+    console.log(`reset ${accounts}`)
+    await contracts.accounts.reset({ authorization: `${accounts}@active` })
+
+    console.log(`reset ${onboarding}`)
+    await contracts.onboarding.reset({ authorization: `${onboarding}@active` })
+
+    console.log(`adduser (${firstuser})`)
+    await contracts.accounts.adduser(firstuser, '', 'individual', { authorization: `${accounts}@active` })
+    await contracts.accounts.testresident(firstuser, { authorization: `${accounts}@active` })
+
+    console.log(`transfer from ${firstuser} to ${onboarding}`)
+    await contracts.token.transfer(firstuser, onboarding, `${6 * batchSize}.0000 SEEDS`, '', { authorization: `${firstuser}@active` })
+
+    let batch = []
+    for (let i = 0; i < batchSize; i++) {
+        const newAccount = randomAccountName()
+        const keyPair = await createKeypair()
+        const inviteSecret = await ramdom64ByteHexString()
+        const inviteHash = sha256(fromHexString(inviteSecret)).toString('hex')
+
+        await contracts.onboarding.invite(firstuser, transferQuantity, sowQuantity, inviteHash, { authorization: `${firstuser}@active` })
+        batch.push([newAccount, inviteSecret, keyPair.public, 'batch user ' + i])
+    }
+
+    const usersBefore = await getTableRows({
+        code: accounts,
+        scope: accounts,
+        table: 'users',
+        json: true
+    })
+
+    console.log(`accept ${batchSize} invites from Application`)
+    await contracts.onboarding.acceptbatch(batch, { authorization: `${onboarding}@application` })
+
+    const usersAfter = await getTableRows({
+        code: accounts,
+        scope: accounts,
+        table: 'users',
+        json: true
+    })
+
+    const refs = await getTableRows({
+        code: accounts,
+        scope: accounts,
+        table: 'refs',
+        json: true
+    })
+
+    const planted = await getTableRows({
+        code: harvest,
+        scope: harvest,
+        table: 'balances',
+        json: true,
+        limit: 100
+    })
+
+    const newAccounts = batch.map(([account]) => account)
+
+    assert({
+        given: 'a batch of invites accepted',
+        should: 'add every invited user',
+        actual: usersAfter.rows.length - usersBefore.rows.length,
+        expected: batchSize
+    })
+
+    assert({
+        given: 'a batch of invites accepted',
+        should: 'add a referral for every invited user',
+        actual: newAccounts.map(account => refs.rows.filter(r => r.invited == account && r.referrer == firstuser).length),
+        expected: newAccounts.map(() => 1)
+    })
+
+    assert({
+        given: 'a batch of invites accepted',
+        should: 'plant the sow amount for every invited user',
+        actual: newAccounts.map(account => (planted.rows.find(r => r.account == account) || {}).planted),
+        expected: newAccounts.map(() => sowQuantity)
+    })
+
+})
+
 describe('Invite from non-seeds user - sp', async assert => {
 
     if (!isLocal()) {
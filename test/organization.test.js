@@ -505,6 +505,43 @@ describe('app', async assert => {
         ]
     })
 
+    const dausWindowTable = await getTableRows({
+        code: organization,
+        scope: organization,
+        table: 'dauswindow',
+        json: true
+    })
+
+    assert({
+        given: 'app use calculated',
+        should: 'keep the trailing window totals per app',
+        actual: dausWindowTable.rows.map(({ app_name, points, users }) => ({ app_name, points, users })),
+        expected: [
+            { app_name: 'app1', points: 6, users: 2 },
+            { app_name: 'app2', points: 22, users: 2 },
+            { app_name: 'app3', points: 0, users: 0 },
+            { app_name: 'app4', points: 20, users: 1 }
+        ]
+    })
+
+    console.log('clean daus')
+    await contracts.organization.cleandaus({ authorization: `${organization}@active` })
+    await sleep(3000)
+
+    const daus2TableAfterClean = await getTableRows({
+        code: organization,
+        scope: 'app2',
+        table: 'daus',
+        json: true
+    })
+
+    assert({
+        given: 'cleandaus called',
+        should: 'keep the days inside the trailing window',
+        actual: daus2TableAfterClean.rows.length,
+        expected: daus2Table.rows.length
+    })
+
     await contracts.organization.rankappuses({ authorization: `${organization}@active` })
     await sleep(3000)
 
@@ -32,7 +32,7 @@ describe('Pool transfer and payout', async assert => {
     assert({
       given,
       should,
-      actual: balanceTable.rows,
+      actual: balanceTable.rows.map(({ account, balance }) => ({ account, balance })),
       expected
     })
     assert({
@@ -45,6 +45,31 @@ describe('Pool transfer and payout', async assert => {
     })
   }
 
+  const getSize = async (id) => {
+    const sizesTable = await getTableRows({
+      code: pool,
+      scope: pool,
+      table: 'sizes',
+      json: true
+    })
+    const row = sizesTable.rows.filter(r => r.id === id)[0]
+    return row ? parseInt(row.size) : 0
+  }
+
+  // payouts only moves the payout index, holders are paid by claim, by moving pool tokens or by this pass,
+  // two holders per chunk so the pass continues in a deferred transaction
+  const settleAll = async () => {
+    console.log('settle all holders')
+    await contracts.pool.settle(0, 2, { authorization: `${pool}@active` })
+    await sleep(4000)
+  }
+
+  // what is left to pay out, total.sz still holds amounts owed by the payout index
+  const availableBalance = async () => {
+    const available = (await getSize('total.sz')) - (await getSize('unsettled.sz'))
+    return `${(available / 10000).toFixed(4)} SEEDS`
+  }
+
   const setupPool = async () => {
     console.log('reset pool')
     await contracts.pool.reset({ authorization: `${pool}@active` })
@@ -85,40 +110,83 @@ describe('Pool transfer and payout', async assert => {
   await contracts.pool.payouts('10.0000 SEEDS', { authorization: `${pool}@active` })
   await sleep(2000)
 
+  await checkBalances({
+    expected: [
+      { account: firstuser, balance: '10.0000 SEEDS' },
+      { account: seconduser, balance: '20.0000 SEEDS' },
+      { account: thirduser, balance: '30.0000 SEEDS' }
+    ],
+    given: 'payout SEEDS',
+    should: 'not settle any holder'
+  })
+
+  await settleAll()
+
   await checkBalances({
     expected: [
       { account: firstuser, balance: '8.3334 SEEDS' },
       { account: seconduser, balance: '16.6667 SEEDS' },
       { account: thirduser, balance: '25.0000 SEEDS' }
     ],
-    given: 'payout SEEDS',
+    given: 'payout SEEDS and settle',
     should: 'have the correct balances'
   })
 
   console.log('payout more Seeds')
   await contracts.pool.payouts('20.0000 SEEDS', { authorization: `${pool}@active` })
-  await sleep(4000)
+  await settleAll()
 
   await checkBalances({
     expected: [
       { account: firstuser, balance: '5.0001 SEEDS' },
       { account: seconduser, balance: '10.0001 SEEDS' },
-      { account: thirduser, balance: '15.0001 SEEDS' }
+      { account: thirduser, balance: '15.0000 SEEDS' }
     ],
     given: 'payout more SEEDS',
     should: 'have the correct balances'
   })
 
   console.log('payout all the Seeds')
-  await contracts.pool.payouts('30.0003 SEEDS', { authorization: `${pool}@active` })
+  const epochBefore = (await getTableRows({ code: pool, scope: pool, table: 'payoutstate', json: true })).rows.map(r => r.epoch)[0] || 0
+  await contracts.pool.payouts(await availableBalance(), { authorization: `${pool}@active` })
   await sleep(2000)
 
+  const epochAfter = (await getTableRows({ code: pool, scope: pool, table: 'payoutstate', json: true })).rows.map(r => r.epoch)[0]
+
+  assert({
+    given: 'payout all SEEDS',
+    should: 'start a new payout epoch',
+    actual: epochAfter,
+    expected: epochBefore + 1
+  })
+
+  console.log('claim from an earlier epoch')
+  const firstBeforeClaim = await getBalanceFloat(firstuser)
+  await contracts.pool.claim(firstuser, { authorization: `${firstuser}@active` })
+  await sleep(1000)
+
+  assert({
+    given: 'claim after a full payout',
+    should: 'pay the whole balance',
+    actual: parseFloat((await getBalanceFloat(firstuser) - firstBeforeClaim).toFixed(4)),
+    expected: 5.0001
+  })
+
+  await settleAll()
+
   await checkBalances({
     expected: [],
     given: 'payout all SEEDS',
     should: 'have the correct balances'
   })
 
+  assert({
+    given: 'every holder settled after a full payout',
+    should: 'have nothing left unsettled',
+    actual: await getSize('unsettled.sz'),
+    expected: 0
+  })
+
   console.log('get balances after')
   let balancesAfter = await Promise.all(users.map(user => getBalanceFloat(user)))
 
@@ -165,19 +233,32 @@ describe('Pool transfer and payout', async assert => {
   await contracts.pool.payouts('10.0000 SEEDS', { authorization: `${pool}@active` })
   await sleep(2000)
 
+  console.log('transfer more HPOOL')
+  await contracts.pool.transfer(firstuser, seconduser, '8.3334 HPOOL', '', { authorization: `${firstuser}@active` })
+
   await checkBalances({
     expected: [
-      { account: firstuser, balance: '8.3334 SEEDS' },
-      { account: seconduser, balance: '12.5000 SEEDS' },
-      { account: thirduser, balance: '12.5000 SEEDS' },
-      { account: fourthuser, balance: '16.6667 SEEDS' }
+      { account: seconduser, balance: '20.8334 SEEDS' },
+      { account: thirduser, balance: '15.0000 SEEDS' },
+      { account: fourthuser, balance: '20.0000 SEEDS' }
     ],
-    given: 'payout SEEDS',
-    should: 'have the correct balances'
+    given: 'transfer more HPOOL',
+    should: 'settle only the sender and the receiver'
   })
 
-  console.log('transfer more HPOOL')
-  await contracts.pool.transfer(firstuser, seconduser, '8.3334 HPOOL', '', { authorization: `${firstuser}@active` })
+  console.log('claim')
+  const claimBefore = await Promise.all([thirduser, fourthuser].map(user => getBalanceFloat(user)))
+  await contracts.pool.claim(thirduser, { authorization: `${thirduser}@active` })
+  await contracts.pool.claim(fourthuser, { authorization: `${fourthuser}@active` })
+  await sleep(1000)
+  const claimAfter = await Promise.all([thirduser, fourthuser].map(user => getBalanceFloat(user)))
+
+  assert({
+    given: 'claim',
+    should: 'pay the share owed since the last settlement',
+    actual: claimAfter.map((balance, index) => parseFloat((balance - claimBefore[index]).toFixed(4))),
+    expected: [ 2.5, 3.3333 ]
+  })
 
   await checkBalances({
     expected: [
@@ -185,18 +266,18 @@ describe('Pool transfer and payout', async assert => {
       { account: thirduser, balance: '12.5000 SEEDS' },
       { account: fourthuser, balance: '16.6667 SEEDS' }
     ],
-    given: 'transfer more HPOOL',
+    given: 'claim',
     should: 'have the correct balances'
   })
 
   console.log('payout more Seeds')
   await contracts.pool.payouts('20.0000 SEEDS', { authorization: `${pool}@active` })
-  await sleep(4000)
+  await settleAll()
 
   await checkBalances({
     expected: [
       { account: seconduser, balance: '12.5001 SEEDS' },
-      { account: thirduser, balance: '7.5001 SEEDS' },
+      { account: thirduser, balance: '7.5000 SEEDS' },
       { account: fourthuser, balance: '10.0001 SEEDS' }
     ],
     given: 'payout more SEEDS',
@@ -204,8 +285,8 @@ describe('Pool transfer and payout', async assert => {
   })
 
   console.log('payout all the Seeds')
-  await contracts.pool.payouts('30.0003 SEEDS', { authorization: `${pool}@active` })
-  await sleep(2000)
+  await contracts.pool.payouts(await availableBalance(), { authorization: `${pool}@active` })
+  await settleAll()
 
   await checkBalances({
     expected: [],
@@ -13,6 +13,34 @@ function sleep(ms) {
   return new Promise(resolve => setTimeout(resolve, ms));
 }
 
+// voice rows hold their balance as of their last write, decay since then is in the cycle table's decay_index
+const getVoiceRows = async (scope) => {
+  const voice = await eos.getTableRows({
+    code: proposals,
+    scope,
+    table: 'voice',
+    json: true,
+  })
+  const cycle = await eos.getTableRows({
+    code: proposals,
+    scope: proposals,
+    table: 'cycle',
+    json: true,
+  })
+  const { decay_index = 0, decay_epoch = 0 } = cycle.rows[0] || {}
+  const rows = voice.rows.map(({ account, balance, ...row }) => {
+    if (scope == 'referendum') {
+      return { account, balance }
+    }
+    if ((row.decay_epoch || 0) != decay_epoch) {
+      return { account, balance: 0 }
+    }
+    const decay = parseFloat(row.decay_index || 0) - parseFloat(decay_index)
+    return { account, balance: Math.floor(balance * Math.exp(decay) + 0.000001) }
+  })
+  return { rows }
+}
+
 let eosDevKey = "EOS6MRyAjQq8ud7hVNYcfnVPJqcVpscN5So8BhtHuGYqET5GDW5CV"
 
 describe('Proposals', async assert => {
@@ -178,12 +206,7 @@ describe('Proposals', async assert => {
 
   let activeProps = activeProposals.rows.filter( item => item.stage == "active")
 
-  const voiceBefore = await eos.getTableRows({
-    code: proposals,
-    scope: proposals,
-    table: 'voice',
-    json: true,
-  })
+  const voiceBefore = await getVoiceRows(proposals)
   let voice = voiceBefore.rows[0].balance
 
   console.log("voice "+JSON.stringify(voice, null, 2))
@@ -231,12 +254,7 @@ describe('Proposals', async assert => {
   await contracts.proposals.addvoice(fourthuser, 0, { authorization: `${proposals}@active` })
   await contracts.harvest.testupdatecs(fourthuser, 80, { authorization: `${harvest}@active` })
 
-  const voice111 = await eos.getTableRows({
-    code: proposals,
-    scope: proposals,
-    table: 'voice',
-    json: true,
-  })
+  const voice111 = await getVoiceRows(proposals)
 
   const repsBefore = await eos.getTableRows({
     code: accounts,
@@ -274,12 +292,7 @@ describe('Proposals', async assert => {
 
   await sleep(2000)
   
-  const voiceAfter = await eos.getTableRows({
-    code: proposals,
-    scope: proposals,
-    table: 'voice',
-    json: true,
-  })
+  const voiceAfter = await getVoiceRows(proposals)
   
   const hasVoice = (voices, user) => {
     return voices.rows.filter(
@@ -298,7 +311,7 @@ describe('Proposals', async assert => {
   const escrowLocks = await eos.getTableRows({
     code: escrow,
     scope: escrow,
-    table: 'locks',
+    table: 'tokenlocks',
     json: true,
   })
 
@@ -546,7 +559,6 @@ describe('Proposals', async assert => {
 
   delete escrowLock.vesting_date
   delete escrowLock.created_date
-  delete escrowLock.updated_date
 
   assert({
     given: 'alliance proposal passed',
@@ -560,6 +572,8 @@ describe('Proposals', async assert => {
       "quantity": "12.0000 SEEDS",
       "trigger_event": "golive",
       "trigger_source": "dao.hypha",
+      "proposal_contract": "funds.seeds",
+      "proposal_id": 4,
       "notes": "proposal id: 4",
     }
   })
@@ -735,7 +749,7 @@ describe('Proposals', async assert => {
   const escrowLocksAfterFinish = await eos.getTableRows({
     code: escrow,
     scope: escrow,
-    table: 'locks',
+    table: 'tokenlocks',
     json: true,
   })
   console.log('escrow locks:', escrowLocksAfterFinish)
@@ -1026,12 +1040,7 @@ describe('Participants', async assert => {
     json: true,
   })
 
-  const voiceAfter = await eos.getTableRows({
-    code: proposals,
-    scope: proposals,
-    table: 'voice',
-    json: true,
-  })
+  const voiceAfter = await getVoiceRows(proposals)
 
   const participantsAfter = await eos.getTableRows({
     code: proposals,
@@ -1141,18 +1150,8 @@ describe('Change Trust', async assert => {
   await contracts.accounts.adduser(firstuser, 'firstuser', 'individual', { authorization: `${accounts}@active` })
 
   let check = async (given, should, expected) => {
-    const voice = await eos.getTableRows({
-      code: proposals,
-      scope: proposals,
-      table: 'voice',
-      json: true,
-    })
-    const voiceAlliance = await eos.getTableRows({
-      code: proposals,
-      scope: 'alliance',
-      table: 'voice',
-      json: true,
-    })
+    const voice = await getVoiceRows(proposals)
+    const voiceAlliance = await getVoiceRows('alliance')
     //console.log('given ' + given + " : "  + JSON.stringify(voice))
     assert({
       given: given,
@@ -1895,26 +1894,11 @@ describe('Voice decay', async assert => {
     await contracts.proposals.decayvoices({ authorization: `${proposals}@active` })
     await sleep(2000)
 
-    const voice = await eos.getTableRows({
-      code: proposals,
-      scope: proposals,
-      table: 'voice',
-      json: true,
-    })
+    const voice = await getVoiceRows(proposals)
 
-    const voiceAlliance = await eos.getTableRows({
-      code: proposals,
-      scope: 'alliance',
-      table: 'voice',
-      json: true,
-    })
+    const voiceAlliance = await getVoiceRows('alliance')
 
-    const voiceHypha = await eos.getTableRows({
-      code: proposals,
-      scope: 'milestone',
-      table: 'voice',
-      json: true,
-    })
+    const voiceHypha = await getVoiceRows('milestone')
 
     assert({
       given: 'ran voice decay for the ' + n + ' time',
@@ -1947,7 +1931,7 @@ describe('Voice decay', async assert => {
   await sleep(1000)
   await testVoiceDecay([34, 75, 0], 4)
   await sleep(4000)
-  await testVoiceDecay([28, 63, 0], 5)
+  await testVoiceDecay([28, 64, 0], 5)
   await sleep(2000)
 
   await contracts.proposals.onperiod({ authorization: `${proposals}@active` })
@@ -2016,19 +2000,9 @@ describe('Voice scope', async assert => {
   await contracts.proposals.favour(seconduser, 2, 8, { authorization: `${seconduser}@active` })
   await contracts.proposals.favour(seconduser, 3, 8, { authorization: `${seconduser}@active` })
 
-  const voiceCampaignsAfter = await eos.getTableRows({
-    code: proposals,
-    scope: proposals,
-    table: 'voice',
-    json: true,
-  })  
+  const voiceCampaignsAfter = await getVoiceRows(proposals)  
 
-  const voiceAlliancesAfter = await eos.getTableRows({
-    code: proposals,
-    scope: 'alliance',
-    table: 'voice',
-    json: true,
-  })
+  const voiceAlliancesAfter = await getVoiceRows('alliance')
 
   assert({
     given: 'voice for campaigns used',
@@ -2142,24 +2116,9 @@ describe('delegate trust', async assert => {
   }
 
   const getVoices = async () => {
-    const voiceCampaigns = await eos.getTableRows({
-      code: proposals,
-      scope: scopeCampaigns,
-      table: 'voice',
-      json: true,
-    })
-    const voiceAlliances = await eos.getTableRows({
-      code: proposals,
-      scope: scopeAlliance,
-      table: 'voice',
-      json: true,
-    })
-    const voiceHypha = await eos.getTableRows({
-      code: proposals,
-      scope: scopeHypha,
-      table: 'voice',
-      json: true,
-    })
+    const voiceCampaigns = await getVoiceRows(scopeCampaigns)
+    const voiceAlliances = await getVoiceRows(scopeAlliance)
+    const voiceHypha = await getVoiceRows(scopeHypha)
     return {
       campaigns: voiceCampaigns.rows,
       alliances: voiceAlliances.rows,
@@ -2715,7 +2674,7 @@ describe('Alliance campaigns', async assert => {
     const lockTable = await eos.getTableRows({
       code: escrow,
       scope: escrow,
-      table: 'locks',
+      table: 'tokenlocks',
       json: true,
     })
     const locks = lockTable.rows.map(r => {
@@ -2949,12 +2908,7 @@ describe('Hypha proposals', async assert => {
 
   await contracts.proposals.favour(thirduser, 2, 1, { authorization: `${thirduser}@active` })
 
-  const voiceTable = await eos.getTableRows({
-    code: proposals,
-    scope: 'milestone',
-    table: 'voice',
-    json: true
-  })
+  const voiceTable = await getVoiceRows('milestone')
   console.log(voiceTable)
 
   assert({
@@ -3,6 +3,9 @@ const R = require('ramda')
 const { eos, names, getTableRows, getBalance, initContracts, isLocal, getBalanceFloat } = require('../scripts/helper');
 const { expect, assert } = require('chai');
 const { stat } = require('fs-extra');
+const crypto = require('crypto')
+const { Serialize } = require('eosjs')
+const { TextEncoder, TextDecoder } = require('util')
 
 const { quests, accounts, settings, escrow, token, firstuser, seconduser, thirduser, fourthuser, fifthuser, campaignbank, proposals, organization } = names
 
@@ -62,7 +65,7 @@ async function getNodesTo (hash, edgeName, verbose=false) {
   const edges = await getTableRows({
     code: quests,
     scope: quests,
-    table: 'edges',
+    table: 'graphedges',
     index_position: 2,
     key_type: 'sha256',
     lower_bound: hash,
@@ -493,7 +496,7 @@ describe('Private quests', async assert => {
   const questLocks = await getTableRows({
     code: escrow,
     scope: escrow,
-    table: 'locks',
+    table: 'tokenlocks',
   })
   console.log(questLocks)
 
@@ -947,7 +950,7 @@ describe('Voted quests', async assert => {
   const questLocks = await getTableRows({
     code: escrow,
     scope: escrow,
-    table: 'locks',
+    table: 'tokenlocks',
   })
   console.log(questLocks)
 
@@ -1302,3 +1305,191 @@ describe('Voted quests timeouts', async assert => {
 
 })
 
+
+const edgeNameBytes = (edgeName) => {
+  const buffer = new Serialize.SerialBuffer({ textEncoder: new TextEncoder(), textDecoder: new TextDecoder() })
+  buffer.pushName(edgeName)
+  return Buffer.from(buffer.asUint8Array())
+}
+
+const sha256Hex = (buffers) => crypto.createHash('sha256').update(Buffer.concat(buffers)).digest('hex')
+
+// same as hypha::foldHash(hashKey(from, to, edgeName)) - xor of the four little endian words
+const edgeId = (from, to, edgeName) => {
+  const hash = Buffer.from(sha256Hex([Buffer.from(from, 'hex'), Buffer.from(to, 'hex'), edgeNameBytes(edgeName)]), 'hex')
+  let id = 0n
+  for (let i = 0; i < 32; i += 8) {
+    id ^= hash.readBigUInt64LE(i)
+  }
+  return id.toString()
+}
+
+describe('Migrate edges', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ quests })
+
+  console.log('reset quests')
+  await contracts.quests.reset({ authorization: `${quests}@active` })
+
+  const randomHash = () => crypto.randomBytes(32).toString('hex')
+  const nodeA = randomHash()
+  const nodeB = randomHash()
+  const nodeC = randomHash()
+
+  const legacyEdges = [
+    { from_node: nodeA, to_node: nodeB, edge_name: 'owns' },
+    { from_node: nodeA, to_node: nodeC, edge_name: 'owns' },
+    { from_node: nodeB, to_node: nodeA, edge_name: 'ownedby' }
+  ]
+
+  console.log('write legacy edges')
+  for (const { from_node, to_node, edge_name } of legacyEdges) {
+    await contracts.quests.testlgcyedge(from_node, to_node, edge_name, { authorization: `${quests}@active` })
+  }
+
+  let pendingError = ''
+  try {
+    console.log('withdraw while edges are not migrated')
+    await contracts.quests.withdraw(quests, '1.0000 SEEDS', { authorization: `${quests}@active` })
+  } catch (err) {
+    pendingError = err.toString()
+  }
+
+  console.log('migrate edges')
+  await contracts.quests.migrateedges(2, { authorization: `${quests}@active` })
+  await sleep(3000)
+
+  const legacyAfter = await getTableRows({
+    code: quests,
+    scope: quests,
+    table: 'edges',
+    json: true
+  })
+
+  const lookups = []
+  for (const { from_node, to_node, edge_name } of legacyEdges) {
+    const byFromTo = await getTableRows({
+      code: quests,
+      scope: quests,
+      table: 'graphedges',
+      index_position: 6,
+      key_type: 'sha256',
+      lower_bound: sha256Hex([Buffer.from(from_node, 'hex'), Buffer.from(to_node, 'hex')]),
+      limit: 1,
+      json: true
+    })
+    const byFromName = await getTableRows({
+      code: quests,
+      scope: quests,
+      table: 'graphedges',
+      index_position: 5,
+      key_type: 'sha256',
+      lower_bound: sha256Hex([Buffer.from(from_node, 'hex'), edgeNameBytes(edge_name)]),
+      limit: 1,
+      json: true
+    })
+    lookups.push({
+      fromTo: byFromTo.rows.map(r => [String(r.id), r.from_node, r.to_node, r.edge_name]),
+      fromName: byFromName.rows.map(r => [r.from_node, r.edge_name]),
+    })
+  }
+
+  assert({
+    given: 'legacy edges not migrated yet',
+    should: 'refuse edge lookups',
+    actual: pendingError.includes('edges migration pending'),
+    expected: true
+  })
+
+  assert({
+    given: 'migrateedges ran in chunks of 2',
+    should: 'empty the legacy edges table',
+    actual: legacyAfter.rows.length,
+    expected: 0
+  })
+
+  assert({
+    given: 'migrated edges',
+    should: 'have folded hash ids and be found by their byfromto and byfromname keys',
+    actual: lookups,
+    expected: legacyEdges.map(({ from_node, to_node, edge_name }) => ({
+      fromTo: [[edgeId(from_node, to_node, edge_name), from_node, to_node, edge_name]],
+      fromName: [[from_node, edge_name]],
+    }))
+  })
+
+})
+
+describe('Erase node edges', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ quests, accounts, settings })
+
+  console.log('reset settings')
+  await contracts.settings.reset({ authorization: `${settings}@active` })
+
+  console.log('reset accounts')
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+
+  console.log('reset quests')
+  await contracts.quests.reset({ authorization: `${quests}@active` })
+
+  console.log('join users')
+  await contracts.accounts.adduser(firstuser, 'firstuser', 'individual', { authorization: `${accounts}@active` })
+
+  console.log('add quest and milestone')
+  await contracts.quests.addquest(firstuser, '100.0000 SEEDS', 'Test quest 1', 'Test quest 1', firstuser, 1, { authorization: `${firstuser}@active` })
+  const quest = (await getQuests(firstuser))[0]
+
+  await contracts.quests.addmilestone(quest.fixed.hash, 'Test milestone title 1', 'milestone description', 10000, { authorization: `${firstuser}@active` })
+  const milestone = (await getMilestones(quest.fixed.hash))[0]
+
+  const getEdges = async (indexPosition, hash) => (await getTableRows({
+    code: quests,
+    scope: quests,
+    table: 'graphedges',
+    index_position: indexPosition,
+    key_type: 'sha256',
+    lower_bound: hash,
+    upper_bound: hash,
+    limit: 500,
+    json: true
+  })).rows.map(r => r.edge_name).sort()
+
+  const fromBefore = await getEdges(2, milestone.fixed.hash)
+  const toBefore = await getEdges(3, milestone.fixed.hash)
+
+  console.log('delete milestone')
+  await contracts.quests.delmilestone(milestone.fixed.hash, { authorization: `${firstuser}@active` })
+
+  assert({
+    given: 'milestone created',
+    should: 'have outgoing and incoming edges',
+    actual: [fromBefore, toBefore],
+    expected: [['milestoneof', 'variable'], ['hasmilestone']]
+  })
+
+  assert({
+    given: 'milestone erased with its edges',
+    should: 'remove the outgoing and the incoming edges',
+    actual: [await getEdges(2, milestone.fixed.hash), await getEdges(3, milestone.fixed.hash)],
+    expected: [[], []]
+  })
+
+  assert({
+    given: 'milestone erased with its edges',
+    should: 'remove the edges to its variable node',
+    actual: await getEdges(3, milestone.variable.hash),
+    expected: []
+  })
+
+})
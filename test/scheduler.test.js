@@ -227,7 +227,7 @@ describe('scheduler', async assert => {
     assert({
         given: '1 second delay was executed 30 seonds',
         should: 'be executed close to 30 times (was: '+delta1+')',
-        actual: delta1 >= 20 && delta1 <= 28, // NOTE: ACTUALLY 27 => 31 - 4, 4 is the other action
+        actual: delta1 >= 24 && delta1 <= 31, // NOTE: due ops run in the same tick, the other action no longer takes turns
         expected: true
     })
 
@@ -248,6 +248,97 @@ describe('scheduler', async assert => {
 })
 
 
+describe('scheduler, paused and not yet due ops', async assert => {
+
+    if (!isLocal()) {
+        console.log("only run unit tests on local - don't reset on mainnet or testnet")
+        return
+    }
+
+    const contracts = await initContracts({ scheduler, settings })
+
+    console.log('scheduler reset')
+    await contracts.scheduler.reset({ authorization: `${scheduler}@active` })
+
+    console.log('configure')
+    await contracts.settings.configure('secndstoexec', 1, { authorization: `${settings}@active` })
+
+    const opTable = await getTableRows({
+        code: scheduler,
+        scope: scheduler,
+        table: 'operations',
+        limit: 200,
+        json: true
+    })
+    for (const op of opTable.rows) {
+        await contracts.scheduler.removeop(op.id, { authorization: `${scheduler}@active` })
+    }
+
+    const now = parseInt(Date.now() / 1000)
+
+    // a paused op and a not yet due op sort before the due op by id
+    console.log('add operations')
+    await contracts.scheduler.configop('a.paused', 'test1', 'cycle.seeds', 1, 0, { authorization: `${scheduler}@active` })
+    await contracts.scheduler.pauseop('a.paused', 1, { authorization: `${scheduler}@active` })
+    await contracts.scheduler.configop('b.later', 'test1', 'cycle.seeds', 1, now + 3600, { authorization: `${scheduler}@active` })
+    await contracts.scheduler.configop('c.due', 'test2', 'cycle.seeds', 2, 0, { authorization: `${scheduler}@active` })
+
+    console.log('reindex operations')
+    await contracts.scheduler.reindexops({ authorization: `${scheduler}@active` })
+
+    await contracts.scheduler.test1({ authorization: `${scheduler}@active` })
+    await contracts.scheduler.test2({ authorization: `${scheduler}@active` })
+
+    const getValues = async () => (await getTableRows({
+        code: scheduler,
+        scope: scheduler,
+        table: 'test',
+        json: true,
+        lower_bound: 'unit.test.1',
+        upper_bound: 'unit.test.2',
+        limit: 100
+    })).rows.map(r => r.value)
+
+    const opsAfterReindex = await getTableRows({
+        code: scheduler,
+        scope: scheduler,
+        table: 'operations',
+        limit: 200,
+        json: true
+    })
+
+    const before = await getValues()
+
+    console.log('scheduler execute')
+    await contracts.scheduler.start({ authorization: `${scheduler}@active` })
+    await sleep(10 * 1000)
+    await contracts.scheduler.stop({ authorization: `${scheduler}@active` })
+
+    const after = await getValues()
+
+    assert({
+        given: 'reindexops',
+        should: 'keep every op',
+        actual: opsAfterReindex.rows.map(r => [r.id, r.pause]),
+        expected: [['a.paused', 1], ['b.later', 0], ['c.due', 0]]
+    })
+
+    assert({
+        given: 'paused and not yet due ops ahead of a due op',
+        should: 'not run them',
+        actual: after[0] - before[0],
+        expected: 0
+    })
+
+    assert({
+        given: 'paused and not yet due ops ahead of a due op',
+        should: 'still run the due op',
+        actual: after[1] - before[1] >= 3,
+        expected: true
+    })
+
+})
+
 describe('scheduler, moon phases', async assert => {
 
     if (!isLocal()) {
@@ -374,7 +465,7 @@ describe('scheduler, moon phases', async assert => {
     assert({
         given: '1 second delay was executed 30 seonds',
         should: 'be executed close to 30 times (was: '+delta1+')',
-        actual: delta1 >= 20 && delta1 <= 28, // NOTE: ACTUALLY 27 => 31 - 4, 4 is the other action
+        actual: delta1 >= 24 && delta1 <= 31, // NOTE: due ops run in the same tick, the other action no longer takes turns
         expected: true
     })
 
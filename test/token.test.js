@@ -87,6 +87,124 @@ describe('token.transfer.history', async assert => {
 
 })
 
+describe('token.transfermany', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ token, history, accounts, settings })
+
+  console.log('configure')
+  await contracts.settings.reset({ authorization: `${settings}@active` })
+
+  console.log('reset token')
+  await contracts.token.resetweekly({ authorization: `${token}@active` })
+
+  console.log('reset history')
+  await contracts.history.reset(firstuser, { authorization: `${history}@active` })
+
+  console.log('accounts reset')
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+
+  await contracts.accounts.adduser(firstuser, '', 'individual', { authorization: `${accounts}@active` })
+  await contracts.accounts.adduser(seconduser, '', 'individual', { authorization: `${accounts}@active` })
+  await contracts.accounts.adduser(thirduser, '', 'individual', { authorization: `${accounts}@active` })
+
+  const balancesBefore = [await getBalance(firstuser), await getBalance(seconduser), await getBalance(thirduser)]
+
+  console.log('transfer many')
+  await contracts.token.transfermany(firstuser, [
+    { to: seconduser, quantity: '10.0000 SEEDS', memo: 'a' },
+    { to: thirduser, quantity: '5.0000 SEEDS', memo: 'b' },
+    { to: seconduser, quantity: '1.0000 SEEDS', memo: 'c' }
+  ], { authorization: `${firstuser}@active` })
+  await sleep(3000)
+
+  const balancesAfter = [await getBalance(firstuser), await getBalance(seconduser), await getBalance(thirduser)]
+
+  let selfTransferFailed = false
+  try {
+    await contracts.token.transfermany(firstuser, [
+      { to: seconduser, quantity: '1.0000 SEEDS', memo: '' },
+      { to: firstuser, quantity: '1.0000 SEEDS', memo: '' }
+    ], { authorization: `${firstuser}@active` })
+  } catch (err) {
+    selfTransferFailed = true
+    console.log('transfer to self failed (expected)')
+  }
+
+  const stats = await getTableRows({
+    code: token,
+    scope: 'SEEDS',
+    table: 'trxstat',
+    json: true
+  })
+
+  const dailyTrxs = await getTableRows({
+    code: history,
+    scope: Math.floor(Date.now() / 1000 / 86400) * 86400,
+    table: 'dailytrxs',
+    json: true
+  })
+
+  assert({
+    given: 'transfermany called',
+    should: 'move every quantity',
+    actual: balancesAfter.map((b, i) => b - balancesBefore[i]),
+    expected: [-16, 11, 5]
+  })
+
+  assert({
+    given: 'transfermany called',
+    should: 'count every transfer in the stats',
+    actual: stats.rows.filter(item => [firstuser, seconduser, thirduser].includes(item.account)),
+    expected: [
+      {
+        account: firstuser,
+        transactions_volume: '16.0000 SEEDS',
+        total_transactions: 3,
+        incoming_transactions: 0,
+        outgoing_transactions: 3
+      },
+      {
+        account: seconduser,
+        transactions_volume: '11.0000 SEEDS',
+        total_transactions: 2,
+        incoming_transactions: 2,
+        outgoing_transactions: 0
+      },
+      {
+        account: thirduser,
+        transactions_volume: '5.0000 SEEDS',
+        total_transactions: 1,
+        incoming_transactions: 1,
+        outgoing_transactions: 0
+      }
+    ]
+  })
+
+  assert({
+    given: 'transfermany called',
+    should: 'save every transfer in history',
+    actual: dailyTrxs.rows.filter(({ from }) => from == firstuser).slice(-3).map(({ from, to, volume }) => ({ from, to, volume })),
+    expected: [
+      { from: firstuser, to: seconduser, volume: 100000 },
+      { from: firstuser, to: thirduser, volume: 50000 },
+      { from: firstuser, to: seconduser, volume: 10000 }
+    ]
+  })
+
+  assert({
+    given: 'a transfer to self in the batch',
+    should: 'fail',
+    actual: selfTransferFailed,
+    expected: true
+  })
+
+})
+
 describe('token.transfer', async assert => {
 
   if (!isLocal()) {